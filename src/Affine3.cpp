@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// Affine3.cpp
+// ===========
+// 3x4 affine transform matrix, the upper 3 rows of Matrix4
+//
+// Dependencies: Matrix3, Matrix4, Vector3, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include "Affine3.h"
+
+const float EPSILON = 0.00001f;         // same as Matrix3::invert()
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctors
+///////////////////////////////////////////////////////////////////////////////
+Affine3::Affine3(const Matrix3& linear, const Vector3& translation)
+{
+    std::memcpy(m, linear.get(), 9 * sizeof(float));
+    m[9]  = translation.x;
+    m[10] = translation.y;
+    m[11] = translation.z;
+}
+
+Affine3::Affine3(const Matrix4& mat)
+{
+    const float* n = mat.get();
+    m[0] = n[0];   m[1] = n[1];   m[2] = n[2];
+    m[3] = n[4];   m[4] = n[5];   m[5] = n[6];
+    m[6] = n[8];   m[7] = n[9];   m[8] = n[10];
+    m[9] = n[12];  m[10]= n[13];  m[11]= n[14];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return 4x4 matrix with the last row (0,0,0,1)
+///////////////////////////////////////////////////////////////////////////////
+Matrix4 Affine3::toMatrix4() const
+{
+    return Matrix4(m[0], m[1], m[2],  0,
+                   m[3], m[4], m[5],  0,
+                   m[6], m[7], m[8],  0,
+                   m[9], m[10], m[11], 1);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inverse of affine transform, same as Matrix4::invertAffine() without
+// checking the last row
+//  [ L | T ]-1 = [ L^-1 | -L^-1 * T ]
+// If the 3x3 part is singular (det=0), set identity matrix.
+///////////////////////////////////////////////////////////////////////////////
+Affine3& Affine3::invert()
+{
+    // adjugate of L
+    float tmp[9];
+    tmp[0] = m[4] * m[8] - m[5] * m[7];
+    tmp[1] = m[7] * m[2] - m[8] * m[1];
+    tmp[2] = m[1] * m[5] - m[2] * m[4];
+    tmp[3] = m[5] * m[6] - m[3] * m[8];
+    tmp[4] = m[0] * m[8] - m[2] * m[6];
+    tmp[5] = m[2] * m[3] - m[0] * m[5];
+    tmp[6] = m[3] * m[7] - m[4] * m[6];
+    tmp[7] = m[6] * m[1] - m[7] * m[0];
+    tmp[8] = m[0] * m[4] - m[1] * m[3];
+
+    float determinant = m[0] * tmp[0] + m[1] * tmp[3] + m[2] * tmp[6];
+    if(fabs(determinant) <= EPSILON)
+    {
+        return identity();
+    }
+
+    // L^-1
+    float invDeterminant = 1.0f / determinant;
+    for(int i = 0; i < 9; ++i)
+        m[i] = invDeterminant * tmp[i];
+
+    // -L^-1 * T
+    float x = m[9];
+    float y = m[10];
+    float z = m[11];
+    m[9]  = -(m[0] * x + m[3] * y + m[6] * z);
+    m[10] = -(m[1] * x + m[4] * y + m[7] * z);
+    m[11] = -(m[2] * x + m[5] * y + m[8] * z);
+
+    return *this;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// translate this matrix by (x, y, z), M' = T * M
+///////////////////////////////////////////////////////////////////////////////
+Affine3& Affine3::translate(float x, float y, float z)
+{
+    m[9]  += x;
+    m[10] += y;
+    m[11] += z;
+    return *this;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// scale this matrix by (sx, sy, sz), M' = S * M
+///////////////////////////////////////////////////////////////////////////////
+Affine3& Affine3::scale(float sx, float sy, float sz)
+{
+    for(int j = 0; j < 12; j += 3)
+    {
+        m[j]   *= sx;
+        m[j+1] *= sy;
+        m[j+2] *= sz;
+    }
+    return *this;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dst[i] = lhs[i] * rhs[i], dst can be lhs or rhs
+///////////////////////////////////////////////////////////////////////////////
+void Affine3::compose(const Affine3* lhs, const Affine3* rhs, Affine3* dst, int count,
+                      ThreadPool* pool)
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; ++i)
+            dst[i] = lhs[i] * rhs[i];
+    });
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dst[i] = transforms[i] * src[i], dst can be src
+///////////////////////////////////////////////////////////////////////////////
+void Affine3::apply(const Affine3* transforms, const Vector3* src, Vector3* dst, int count,
+                    ThreadPool* pool)
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; ++i)
+            dst[i] = transforms[i] * src[i];
+    });
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// transform count vertices (x,y,z) of src, and store them to dst
+// The stride is the number of bytes to the next vertex, same as
+// Matrix4::transformVertices(). src and dst can be same.
+///////////////////////////////////////////////////////////////////////////////
+void Affine3::transformVertices(const float* src, float* dst, int count,
+                                int srcStride, int dstStride) const
+{
+    const char* in = (const char*)src;
+    char* out = (char*)dst;
+    for(int i = 0; i < count; ++i, in += srcStride, out += dstStride)
+    {
+        const float* v = (const float*)in;
+        float x = v[0], y = v[1], z = v[2];
+
+        float* o = (float*)out;
+        o[0] = m[0]*x + m[3]*y + m[6]*z + m[9];
+        o[1] = m[1]*x + m[4]*y + m[7]*z + m[10];
+        o[2] = m[2]*x + m[5]*y + m[8]*z + m[11];
+    }
+}
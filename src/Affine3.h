@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// Affine3.h
+// =========
+// 3x4 affine transform matrix, the upper 3 rows of Matrix4 whose last row is
+// always (0,0,0,1). It is 48 bytes instead of 64 (Matrix4A), and compose,
+// apply and invert skip the last row and the classification of
+// Matrix4::invert().
+//
+// The elements of the matrix are stored as column major order, same as
+// Matrix3 followed by the translation.
+// |  0  3  6  9 |
+// |  1  4  7 10 |
+// |  2  5  8 11 |
+//
+// NOTE:
+// 1. operator*(Vector3) applies the full transform to a point (w = 1).
+//    transformVector() applies the 3x3 part only (w = 0).
+// 2. compose()/apply() are the batch versions of operator*, and they run on
+//    the threads of pool if it is given.
+//
+// Dependencies: Matrix3, Matrix4, Vector3, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AFFINE3_H_DEF
+#define AFFINE3_H_DEF
+
+#include <cstring>
+#include "Matrices.h"
+#include "ThreadPool.h"
+
+class Affine3
+{
+public:
+    // ctors
+    Affine3()                                   { identity(); }     // init with identity
+    explicit Affine3(const float src[12])       { set(src); }
+    Affine3(const Matrix3& linear, const Vector3& translation);
+    explicit Affine3(const Matrix4& mat);       // ignore the last row of mat
+
+    void        set(const float src[12])        { std::memcpy(m, src, sizeof(m)); }
+    const float* get() const                    { return m; }
+    Matrix3     getLinear() const               { return Matrix3(m); }                  // 3x3 part
+    Vector3     getTranslation() const          { return Vector3(m[9], m[10], m[11]); }
+    Matrix4     toMatrix4() const;
+
+    Affine3&    identity();
+    Affine3&    invert();                       // if it is singular, set identity
+    Affine3&    translate(float x, float y, float z);   // pre-multiply translation
+    Affine3&    translate(const Vector3& v)     { return translate(v.x, v.y, v.z); }
+    Affine3&    scale(float sx, float sy, float sz);    // pre-multiply scale
+    Affine3&    scale(float s)                  { return scale(s, s, s); }
+
+    Vector3     transformVector(const Vector3& v) const;    // v' = L * v, no translation
+
+    // operators
+    Vector3     operator*(const Vector3& rhs) const;    // v' = M * v (w = 1)
+    Affine3     operator*(const Affine3& rhs) const;    // M3 = M1 * M2
+    Affine3&    operator*=(const Affine3& rhs);         // M1' = M1 * M2
+    bool        operator==(const Affine3& rhs) const    { return std::memcmp(m, rhs.m, sizeof(m)) == 0; }
+    bool        operator!=(const Affine3& rhs) const    { return !(*this == rhs); }
+    float       operator[](int index) const             { return m[index]; }
+    float&      operator[](int index)                   { return m[index]; }
+
+    // batch
+    static void compose(const Affine3* lhs, const Affine3* rhs, Affine3* dst, int count,
+                        ThreadPool* pool=0);                    // dst[i] = lhs[i] * rhs[i]
+    static void apply(const Affine3* transforms, const Vector3* src, Vector3* dst, int count,
+                      ThreadPool* pool=0);                      // dst[i] = M[i] * src[i]
+    void        transformVertices(const float* src, float* dst, int count,
+                                  int srcStride=12, int dstStride=12) const;    // same as Matrix4
+
+    friend std::ostream& operator<<(std::ostream& os, const Affine3& m);
+
+private:
+    float m[12];
+};
+
+static_assert(sizeof(Affine3) == 48, "Affine3 must be 48 bytes");
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inline functions for Affine3
+///////////////////////////////////////////////////////////////////////////////
+inline Affine3& Affine3::identity()
+{
+    m[0] = m[4] = m[8] = 1.0f;
+    m[1] = m[2] = m[3] = m[5] = m[6] = m[7] = m[9] = m[10] = m[11] = 0.0f;
+    return *this;
+}
+
+
+
+inline Vector3 Affine3::transformVector(const Vector3& v) const
+{
+    return Vector3(m[0]*v.x + m[3]*v.y + m[6]*v.z,
+                   m[1]*v.x + m[4]*v.y + m[7]*v.z,
+                   m[2]*v.x + m[5]*v.y + m[8]*v.z);
+}
+
+
+
+inline Vector3 Affine3::operator*(const Vector3& rhs) const
+{
+    return Vector3(m[0]*rhs.x + m[3]*rhs.y + m[6]*rhs.z + m[9],
+                   m[1]*rhs.x + m[4]*rhs.y + m[7]*rhs.z + m[10],
+                   m[2]*rhs.x + m[5]*rhs.y + m[8]*rhs.z + m[11]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// [L1|T1] * [L2|T2] = [L1*L2 | L1*T2 + T1]
+// 36 multiplies instead of 64 of Matrix4
+///////////////////////////////////////////////////////////////////////////////
+inline Affine3 Affine3::operator*(const Affine3& rhs) const
+{
+    const float* n = rhs.m;
+    Affine3 r;
+    for(int j = 0; j < 12; j += 3)
+    {
+        r.m[j]   = m[0]*n[j] + m[3]*n[j+1] + m[6]*n[j+2];
+        r.m[j+1] = m[1]*n[j] + m[4]*n[j+1] + m[7]*n[j+2];
+        r.m[j+2] = m[2]*n[j] + m[5]*n[j+1] + m[8]*n[j+2];
+    }
+    r.m[9]  += m[9];
+    r.m[10] += m[10];
+    r.m[11] += m[11];
+    return r;
+}
+
+
+
+inline Affine3& Affine3::operator*=(const Affine3& rhs)
+{
+    *this = *this * rhs;
+    return *this;
+}
+
+
+
+inline std::ostream& operator<<(std::ostream& os, const Affine3& m)
+{
+    os << std::fixed << std::setprecision(5);
+    os << "[" << std::setw(10) << m[0] << " " << std::setw(10) << m[3] << " " << std::setw(10) << m[6] << " " << std::setw(10) << m[9] << "]\n"
+       << "[" << std::setw(10) << m[1] << " " << std::setw(10) << m[4] << " " << std::setw(10) << m[7] << " " << std::setw(10) << m[10] << "]\n"
+       << "[" << std::setw(10) << m[2] << " " << std::setw(10) << m[5] << " " << std::setw(10) << m[8] << " " << std::setw(10) << m[11] << "]\n";
+    os << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
+    return os;
+}
+
+#endif
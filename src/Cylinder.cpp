@@ -11,7 +11,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2018-03-27
-// UPDATED: 2020-03-14
+// UPDATED: 2026-10-17
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef _WIN32
@@ -28,13 +28,53 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 #include "Cylinder.h"
+#include "VectorBatch.h"
 
 
 
 // constants //////////////////////////////////////////////////////////////////
+constexpr float PI = 3.14159265f;       // same float as acos(-1)
 const int MIN_SECTOR_COUNT = 3;
 const int MIN_STACK_COUNT  = 1;
+const int INTERLEAVED_FLOAT_COUNT = 8;  // V/N/T: x,y,z, nx,ny,nz, s,t (32 bytes)
+const float COMPACT_POSITION_SCALE = 32767.0f;  // snorm16
+const float COMPACT_NORMAL_SCALE = 127.0f;      // snorm8
+const float COMPACT_TEXCOORD_SCALE = 32767.0f;  // [0, 1] to [0, 32767]
+const unsigned int MAX_COMPACT_VERTEX_COUNT = 65536;    // for 16-bit indices
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write 3 indices of a triangle (or 2 of a line), and return the next position
+///////////////////////////////////////////////////////////////////////////////
+static inline unsigned int* putIndices(unsigned int* p, unsigned int i1, unsigned int i2,
+                                       unsigned int i3)
+{
+    p[0] = i1;
+    p[1] = i2;
+    p[2] = i3;
+    return p + 3;
+}
+
+static inline unsigned int* putLine(unsigned int* p, unsigned int i1, unsigned int i2)
+{
+    p[0] = i1;
+    p[1] = i2;
+    return p + 2;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// quantize x to [-scale, scale] (or [0, scale]) with rounding
+///////////////////////////////////////////////////////////////////////////////
+static inline int quantize(float x, float minX, float scale)
+{
+    x = (x < minX) ? minX : ((x > 1) ? 1 : x);
+    return (int)lroundf(x * scale);
+}
 
 
 
@@ -42,8 +82,13 @@ const int MIN_STACK_COUNT  = 1;
 // ctor
 ///////////////////////////////////////////////////////////////////////////////
 Cylinder::Cylinder(float baseRadius, float topRadius, float height, int sectors,
-                   int stacks, bool smooth) : interleavedStride(32)
+                   int stacks, bool smooth) : vertexCount(0), indexCount(0), lineIndexCount(0),
+                                              separateArrays(true), instanced(false), compact(false),
+                                              interleavedStride(INTERLEAVED_FLOAT_COUNT * sizeof(float))
 {
+    for(int i = 0; i < 16; ++i)
+        transform[i] = (i % 5 == 0) ? 1.0f : 0.0f;  // identity
+    compactScale[0] = compactScale[1] = compactScale[2] = 1.0f;
     set(baseRadius, topRadius, height, sectors, stacks, smooth);
 }
 
@@ -55,24 +100,59 @@ Cylinder::Cylinder(float baseRadius, float topRadius, float height, int sectors,
 void Cylinder::set(float baseRadius, float topRadius, float height, int sectors,
                    int stacks, bool smooth)
 {
+    if(sectors < MIN_SECTOR_COUNT)
+        sectors = MIN_SECTOR_COUNT;
+    if(stacks < MIN_STACK_COUNT)
+        stacks = MIN_STACK_COUNT;
+
+    // size of the mesh to build
+    // In instanced mode, the mesh is the unit cylinder of the same taper ratio
+    // (max radius = 1, height = 1), and the transform scales it to the size.
+    float meshBase = baseRadius;
+    float meshTop = topRadius;
+    float meshH = height;
+    float radiusScale = 1;
+    float heightScale = 1;
+    if(instanced)
+    {
+        radiusScale = std::max(baseRadius, topRadius);
+        if(radiusScale != 0)
+        {
+            meshBase = baseRadius / radiusScale;
+            meshTop = topRadius / radiusScale;
+        }
+        else
+        {
+            meshBase = meshTop = 1;
+        }
+        meshH = 1;
+        heightScale = height;
+    }
+    transform[0] = radiusScale;
+    transform[5] = radiusScale;
+    transform[10] = heightScale;
+
+    // keep the mesh if it is same, only the size changed in instanced mode
+    bool rebuild = vertexCount == 0 ||
+                   this->sectorCount != sectors || this->stackCount != stacks ||
+                   this->smooth != smooth || meshBaseRadius != meshBase ||
+                   meshTopRadius != meshTop || meshHeight != meshH;
+
     this->baseRadius = baseRadius;
     this->topRadius = topRadius;
     this->height = height;
     this->sectorCount = sectors;
-    if(sectors < MIN_SECTOR_COUNT)
-        this->sectorCount = MIN_SECTOR_COUNT;
     this->stackCount = stacks;
-    if(stacks < MIN_STACK_COUNT)
-        this->stackCount = MIN_STACK_COUNT;
     this->smooth = smooth;
+    this->meshBaseRadius = meshBase;
+    this->meshTopRadius = meshTop;
+    this->meshHeight = meshH;
+    if(!rebuild)
+        return;
 
     // generate unit circle vertices first
     buildUnitCircleVertices();
-
-    if(smooth)
-        buildVerticesSmooth();
-    else
-        buildVerticesFlat();
+    buildVertices();
 }
 
 void Cylinder::setBaseRadius(float radius)
@@ -111,10 +191,42 @@ void Cylinder::setSmooth(bool smooth)
         return;
 
     this->smooth = smooth;
-    if(smooth)
-        buildVerticesSmooth();
-    else
-        buildVerticesFlat();
+    buildVertices();
+}
+
+// build the unit mesh of the same taper ratio and scale it with the transform
+// (see getTransform()), so the radius/height changes do not rebuild the mesh
+// but only update the transform
+void Cylinder::setInstanced(bool enable)
+{
+    if(this->instanced == enable)
+        return;
+
+    this->instanced = enable;
+    set(baseRadius, topRadius, height, sectorCount, stackCount, smooth);
+}
+
+// keep the separate vertex/normal/texCoord arrays or not
+// If disabled, only the interleaved array is built (half the memory), and
+// getVertices()/getNormals()/getTexCoords() return empty arrays.
+void Cylinder::setSeparateArrays(bool enable)
+{
+    if(this->separateArrays == enable)
+        return;
+
+    this->separateArrays = enable;
+    buildVertices();
+}
+
+// store the vertices in the compact format (see CompactVertex), 16 bytes per
+// vertex and 16-bit indices, and release the float arrays
+void Cylinder::setCompact(bool enable)
+{
+    if(this->compact == enable)
+        return;
+
+    this->compact = enable;
+    buildVertices();
 }
 
 
@@ -131,6 +243,8 @@ void Cylinder::printSelf() const
               << "  Sector Count: " << sectorCount << "\n"
               << "   Stack Count: " << stackCount << "\n"
               << "Smooth Shading: " << (smooth ? "true" : "false") << "\n"
+              << "     Instanced: " << (instanced ? "true" : "false") << "\n"
+              << "       Compact: " << (compact ? "true" : "false") << "\n"
               << "Triangle Count: " << getTriangleCount() << "\n"
               << "   Index Count: " << getIndexCount() << "\n"
               << "  Vertex Count: " << getVertexCount() << "\n"
@@ -146,19 +260,9 @@ void Cylinder::printSelf() const
 ///////////////////////////////////////////////////////////////////////////////
 void Cylinder::draw() const
 {
-    // interleaved array
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-    glVertexPointer(3, GL_FLOAT, interleavedStride, &interleavedVertices[0]);
-    glNormalPointer(GL_FLOAT, interleavedStride, &interleavedVertices[3]);
-    glTexCoordPointer(2, GL_FLOAT, interleavedStride, &interleavedVertices[6]);
-
-    glDrawElements(GL_TRIANGLES, (unsigned int)indices.size(), GL_UNSIGNED_INT, indices.data());
-
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    bool normalize = beginDraw(false);
+    drawTriangles(0, indexCount);
+    endDraw(normalize, false);
 }
 
 
@@ -168,19 +272,9 @@ void Cylinder::draw() const
 ///////////////////////////////////////////////////////////////////////////////
 void Cylinder::drawSide() const
 {
-    // interleaved array
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-    glVertexPointer(3, GL_FLOAT, interleavedStride, &interleavedVertices[0]);
-    glNormalPointer(GL_FLOAT, interleavedStride, &interleavedVertices[3]);
-    glTexCoordPointer(2, GL_FLOAT, interleavedStride, &interleavedVertices[6]);
-
-    glDrawElements(GL_TRIANGLES, baseIndex, GL_UNSIGNED_INT, indices.data());
-
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    bool normalize = beginDraw(false);
+    drawTriangles(0, baseIndex);
+    endDraw(normalize, false);
 }
 
 
@@ -190,38 +284,16 @@ void Cylinder::drawSide() const
 ///////////////////////////////////////////////////////////////////////////////
 void Cylinder::drawBase() const
 {
-    // interleaved array
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-    glVertexPointer(3, GL_FLOAT, interleavedStride, &interleavedVertices[0]);
-    glNormalPointer(GL_FLOAT, interleavedStride, &interleavedVertices[3]);
-    glTexCoordPointer(2, GL_FLOAT, interleavedStride, &interleavedVertices[6]);
-
-    unsigned int indexCount = ((unsigned int)indices.size() - baseIndex) / 2;
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, &indices[baseIndex]);
-
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    bool normalize = beginDraw(false);
+    drawTriangles(baseIndex, getBaseIndexCount());
+    endDraw(normalize, false);
 }
 
 void Cylinder::drawTop() const
 {
-    // interleaved array
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-    glVertexPointer(3, GL_FLOAT, interleavedStride, &interleavedVertices[0]);
-    glNormalPointer(GL_FLOAT, interleavedStride, &interleavedVertices[3]);
-    glTexCoordPointer(2, GL_FLOAT, interleavedStride, &interleavedVertices[6]);
-
-    unsigned int indexCount = ((unsigned int)indices.size() - baseIndex) / 2;
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, &indices[topIndex]);
-
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    bool normalize = beginDraw(false);
+    drawTriangles(topIndex, getTopIndexCount());
+    endDraw(normalize, false);
 }
 
 
@@ -239,18 +311,101 @@ void Cylinder::drawLines(const float lineColor[4]) const
     // draw lines with VA
     glDisable(GL_LIGHTING);
     glDisable(GL_TEXTURE_2D);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glVertexPointer(3, GL_FLOAT, 0, vertices.data());
+    bool normalize = beginDraw(true);
 
-    glDrawElements(GL_LINES, (unsigned int)lineIndices.size(), GL_UNSIGNED_INT, lineIndices.data());
+    if(!compactLineIndices.empty())
+        glDrawElements(GL_LINES, lineIndexCount, GL_UNSIGNED_SHORT, compactLineIndices.data());
+    else
+        glDrawElements(GL_LINES, lineIndexCount, GL_UNSIGNED_INT, lineIndices.data());
 
-    glDisableClientState(GL_VERTEX_ARRAY);
+    endDraw(normalize, true);
     glEnable(GL_LIGHTING);
     glEnable(GL_TEXTURE_2D);
 }
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// set the vertex arrays and the transform to draw
+// The instance transform and the scale of compact positions are multiplied to
+// the modelview matrix, and GL_NORMALIZE is enabled for the normals of the
+// scaled mesh. The compact texCoords are scaled with the texture matrix.
+// return if GL_NORMALIZE was enabled to restore it in endDraw()
+///////////////////////////////////////////////////////////////////////////////
+bool Cylinder::beginDraw(bool positionOnly) const
+{
+    bool normalize = true;
+    if(instanced || compact)
+    {
+        normalize = glIsEnabled(GL_NORMALIZE) == GL_TRUE;
+        glEnable(GL_NORMALIZE);
+        glPushMatrix();
+        if(instanced)
+            glMultMatrixf(transform);
+        if(compact)
+            glScalef(compactScale[0], compactScale[1], compactScale[2]);
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    if(compact)
+        glVertexPointer(3, GL_SHORT, sizeof(CompactVertex), &compactVertices[0].x);
+    else
+        glVertexPointer(3, GL_FLOAT, interleavedStride, &interleavedVertices[0]);
+    if(positionOnly)
+        return normalize;
+
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    if(compact)
+    {
+        glNormalPointer(GL_BYTE, sizeof(CompactVertex), &compactVertices[0].nx);
+        glTexCoordPointer(2, GL_SHORT, sizeof(CompactVertex), &compactVertices[0].s);
+
+        glMatrixMode(GL_TEXTURE);
+        glPushMatrix();
+        glScalef(1.0f / COMPACT_TEXCOORD_SCALE, 1.0f / COMPACT_TEXCOORD_SCALE, 1);
+        glMatrixMode(GL_MODELVIEW);
+    }
+    else
+    {
+        glNormalPointer(GL_FLOAT, interleavedStride, &interleavedVertices[3]);
+        glTexCoordPointer(2, GL_FLOAT, interleavedStride, &interleavedVertices[6]);
+    }
+    return normalize;
+}
+
+void Cylinder::endDraw(bool normalize, bool positionOnly) const
+{
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if(!positionOnly)
+    {
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        if(compact)
+        {
+            glMatrixMode(GL_TEXTURE);
+            glPopMatrix();
+            glMatrixMode(GL_MODELVIEW);
+        }
+    }
+
+    if(instanced || compact)
+        glPopMatrix();
+    if(!normalize)
+        glDisable(GL_NORMALIZE);
+}
+
+// draw count triangle indices from first with 16-bit or 32-bit indices
+void Cylinder::drawTriangles(unsigned int first, unsigned int count) const
+{
+    if(!compactIndices.empty())
+        glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, compactIndices.data() + first);
+    else
+        glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, indices.data() + first);
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // draw a cylinder surfaces and lines on top of it
 // the caller must set the line width before call this
@@ -278,6 +433,52 @@ void Cylinder::clearArrays()
     std::vector<float>().swap(texCoords);
     std::vector<unsigned int>().swap(indices);
     std::vector<unsigned int>().swap(lineIndices);
+    std::vector<float>().swap(interleavedVertices);
+    std::vector<CompactVertex>().swap(compactVertices);
+    std::vector<unsigned short>().swap(compactIndices);
+    std::vector<unsigned short>().swap(compactLineIndices);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// allocate all arrays with the exact sizes at once, so the builders write the
+// elements directly without push_back() and copying
+// The separate vertex/normal/texCoord arrays are allocated only if enabled.
+///////////////////////////////////////////////////////////////////////////////
+void Cylinder::resizeArrays(unsigned int vertexCount, unsigned int indexCount,
+                            unsigned int lineIndexCount)
+{
+    clearArrays();
+
+    this->vertexCount = vertexCount;
+    this->indexCount = indexCount;
+    this->lineIndexCount = lineIndexCount;
+    interleavedVertices.resize(vertexCount * INTERLEAVED_FLOAT_COUNT);
+    if(separateArrays)
+    {
+        vertices.resize(vertexCount * 3);
+        normals.resize(vertexCount * 3);
+        texCoords.resize(vertexCount * 2);
+    }
+    indices.resize(indexCount);
+    lineIndices.resize(lineIndexCount);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build vertices of smooth or flat shading, and the compact vertices if enabled
+///////////////////////////////////////////////////////////////////////////////
+void Cylinder::buildVertices()
+{
+    if(smooth)
+        buildVerticesSmooth();
+    else
+        buildVerticesFlat();
+
+    if(compact)
+        buildCompactVertices();
 }
 
 
@@ -285,15 +486,21 @@ void Cylinder::clearArrays()
 ///////////////////////////////////////////////////////////////////////////////
 // build vertices of cylinder with smooth shading
 // where v: sector angle (0 <= v <= 360)
+// # of vertices: (stackCount+1)*(sectorCount+1) for side, and
+//                (sectorCount+1) for each of base and top
 ///////////////////////////////////////////////////////////////////////////////
 void Cylinder::buildVerticesSmooth()
 {
-    // clear memory of prev arrays
-    clearArrays();
+    unsigned int sideVertexCount = (stackCount + 1) * (sectorCount + 1);
+    unsigned int vertexCount = sideVertexCount + 2 * (sectorCount + 1);
+    unsigned int indexCount = stackCount * sectorCount * 6 + sectorCount * 6;
+    unsigned int lineIndexCount = stackCount * sectorCount * 4 + sectorCount * 2;
+    resizeArrays(vertexCount, indexCount, lineIndexCount);
 
     float x, y, z;                                  // vertex position
     //float s, t;                                     // texCoord
     float radius;                                   // radius for each stack
+    unsigned int vertexIndex = 0;
 
     // get normals for cylinder sides
     std::vector<float> sideNormals = getSideNormals();
@@ -301,55 +508,51 @@ void Cylinder::buildVerticesSmooth()
     // put vertices of side cylinder to array by scaling unit circle
     for(int i = 0; i <= stackCount; ++i)
     {
-        z = -(height * 0.5f) + (float)i / stackCount * height;      // vertex position z
-        radius = baseRadius + (float)i / stackCount * (topRadius - baseRadius);     // lerp
+        z = -(meshHeight * 0.5f) + (float)i / stackCount * meshHeight;      // vertex position z
+        radius = meshBaseRadius + (float)i / stackCount * (meshTopRadius - meshBaseRadius);     // lerp
         float t = 1.0f - (float)i / stackCount;   // top-to-bottom
 
         for(int j = 0, k = 0; j <= sectorCount; ++j, k += 3)
         {
             x = unitCircleVertices[k];
             y = unitCircleVertices[k+1];
-            addVertex(x * radius, y * radius, z);   // position
-            addNormal(sideNormals[k], sideNormals[k+1], sideNormals[k+2]); // normal
-            addTexCoord((float)j / sectorCount, t); // tex coord
+            setVertex(vertexIndex++, x * radius, y * radius, z,                     // position
+                      sideNormals[k], sideNormals[k+1], sideNormals[k+2],           // normal
+                      (float)j / sectorCount, t);                                   // tex coord
         }
     }
 
     // remember where the base.top vertices start
-    unsigned int baseVertexIndex = (unsigned int)vertices.size() / 3;
+    unsigned int baseVertexIndex = vertexIndex;
 
     // put vertices of base of cylinder
-    z = -height * 0.5f;
-    addVertex(0, 0, z);
-    addNormal(0, 0, -1);
-    addTexCoord(0.5f, 0.5f);
+    z = -meshHeight * 0.5f;
+    setVertex(vertexIndex++, 0, 0, z, 0, 0, -1, 0.5f, 0.5f);
     for(int i = 0, j = 0; i < sectorCount; ++i, j += 3)
     {
         x = unitCircleVertices[j];
         y = unitCircleVertices[j+1];
-        addVertex(x * baseRadius, y * baseRadius, z);
-        addNormal(0, 0, -1);
-        addTexCoord(-x * 0.5f + 0.5f, -y * 0.5f + 0.5f);    // flip horizontal
+        setVertex(vertexIndex++, x * meshBaseRadius, y * meshBaseRadius, z, 0, 0, -1,
+                  -x * 0.5f + 0.5f, -y * 0.5f + 0.5f);      // flip horizontal
     }
 
     // remember where the base vertices start
-    unsigned int topVertexIndex = (unsigned int)vertices.size() / 3;
+    unsigned int topVertexIndex = vertexIndex;
 
     // put vertices of top of cylinder
-    z = height * 0.5f;
-    addVertex(0, 0, z);
-    addNormal(0, 0, 1);
-    addTexCoord(0.5f, 0.5f);
+    z = meshHeight * 0.5f;
+    setVertex(vertexIndex++, 0, 0, z, 0, 0, 1, 0.5f, 0.5f);
     for(int i = 0, j = 0; i < sectorCount; ++i, j += 3)
     {
         x = unitCircleVertices[j];
         y = unitCircleVertices[j+1];
-        addVertex(x * topRadius, y * topRadius, z);
-        addNormal(0, 0, 1);
-        addTexCoord(x * 0.5f + 0.5f, -y * 0.5f + 0.5f);
+        setVertex(vertexIndex++, x * meshTopRadius, y * meshTopRadius, z, 0, 0, 1,
+                  x * 0.5f + 0.5f, -y * 0.5f + 0.5f);
     }
 
     // put indices for sides
+    unsigned int* index = &indices[0];
+    unsigned int* lineIndex = &lineIndices[0];
     unsigned int k1, k2;
     for(int i = 0; i < stackCount; ++i)
     {
@@ -359,48 +562,40 @@ void Cylinder::buildVerticesSmooth()
         for(int j = 0; j < sectorCount; ++j, ++k1, ++k2)
         {
             // 2 trianles per sector
-            addIndices(k1, k1 + 1, k2);
-            addIndices(k2, k1 + 1, k2 + 1);
+            index = putIndices(index, k1, k1 + 1, k2);
+            index = putIndices(index, k2, k1 + 1, k2 + 1);
 
             // vertical lines for all stacks
-            lineIndices.push_back(k1);
-            lineIndices.push_back(k2);
+            lineIndex = putLine(lineIndex, k1, k2);
             // horizontal lines
-            lineIndices.push_back(k2);
-            lineIndices.push_back(k2 + 1);
+            lineIndex = putLine(lineIndex, k2, k2 + 1);
             if(i == 0)
-            {
-                lineIndices.push_back(k1);
-                lineIndices.push_back(k1 + 1);
-            }
+                lineIndex = putLine(lineIndex, k1, k1 + 1);
         }
     }
 
     // remember where the base indices start
-    baseIndex = (unsigned int)indices.size();
+    baseIndex = (unsigned int)(index - &indices[0]);
 
     // put indices for base
     for(int i = 0, k = baseVertexIndex + 1; i < sectorCount; ++i, ++k)
     {
         if(i < (sectorCount - 1))
-            addIndices(baseVertexIndex, k + 1, k);
+            index = putIndices(index, baseVertexIndex, k + 1, k);
         else    // last triangle
-            addIndices(baseVertexIndex, baseVertexIndex + 1, k);
+            index = putIndices(index, baseVertexIndex, baseVertexIndex + 1, k);
     }
 
     // remember where the base indices start
-    topIndex = (unsigned int)indices.size();
+    topIndex = (unsigned int)(index - &indices[0]);
 
     for(int i = 0, k = topVertexIndex + 1; i < sectorCount; ++i, ++k)
     {
         if(i < (sectorCount - 1))
-            addIndices(topVertexIndex, k, k + 1);
+            index = putIndices(index, topVertexIndex, k, k + 1);
         else
-            addIndices(topVertexIndex, k, topVertexIndex + 1);
+            index = putIndices(index, topVertexIndex, k, topVertexIndex + 1);
     }
-
-    // generate interleaved vertex array as well
-    buildInterleavedVertices();
 }
 
 
@@ -408,6 +603,8 @@ void Cylinder::buildVerticesSmooth()
 ///////////////////////////////////////////////////////////////////////////////
 // generate vertices with flat shading
 // each triangle is independent (no shared vertices)
+// # of vertices: 4 per quad for side, and (sectorCount+1) for each of base
+//                and top
 ///////////////////////////////////////////////////////////////////////////////
 void Cylinder::buildVerticesFlat()
 {
@@ -416,7 +613,7 @@ void Cylinder::buildVerticesFlat()
     {
         float x, y, z, s, t;
     };
-    std::vector<Vertex> tmpVertices;
+    std::vector<Vertex> tmpVertices((stackCount + 1) * (sectorCount + 1));
 
     int i, j, k;    // indices
     float x, y, z, s, t, radius;
@@ -424,35 +621,41 @@ void Cylinder::buildVerticesFlat()
     // put tmp vertices of cylinder side to array by scaling unit circle
     //NOTE: start and end vertex positions are same, but texcoords are different
     //      so, add additional vertex at the end point
+    Vertex* vertex = &tmpVertices[0];
     for(i = 0; i <= stackCount; ++i)
     {
-        z = -(height * 0.5f) + (float)i / stackCount * height;      // vertex position z
-        radius = baseRadius + (float)i / stackCount * (topRadius - baseRadius);     // lerp
+        z = -(meshHeight * 0.5f) + (float)i / stackCount * meshHeight;      // vertex position z
+        radius = meshBaseRadius + (float)i / stackCount * (meshTopRadius - meshBaseRadius);     // lerp
         t = 1.0f - (float)i / stackCount;   // top-to-bottom
 
-        for(j = 0, k = 0; j <= sectorCount; ++j, k += 3)
+        for(j = 0, k = 0; j <= sectorCount; ++j, k += 3, ++vertex)
         {
             x = unitCircleVertices[k];
             y = unitCircleVertices[k+1];
             s = (float)j / sectorCount;
 
-            Vertex vertex;
-            vertex.x = x * radius;
-            vertex.y = y * radius;
-            vertex.z = z;
-            vertex.s = s;
-            vertex.t = t;
-            tmpVertices.push_back(vertex);
+            vertex->x = x * radius;
+            vertex->y = y * radius;
+            vertex->z = z;
+            vertex->s = s;
+            vertex->t = t;
         }
     }
 
-    // clear memory of prev arrays
-    clearArrays();
+    unsigned int vertexCount = stackCount * sectorCount * 4 + 2 * (sectorCount + 1);
+    unsigned int indexCount = stackCount * sectorCount * 6 + sectorCount * 6;
+    unsigned int lineIndexCount = stackCount * sectorCount * 4 + sectorCount * 2;
+    resizeArrays(vertexCount, indexCount, lineIndexCount);
 
     Vertex v1, v2, v3, v4;      // 4 vertex positions v1, v2, v3, v4
-    std::vector<float> n;       // 1 face normal
+    const float* n;             // 1 face normal
     int vi1, vi2;               // indices
-    int index = 0;
+    unsigned int vertexIndex = 0;
+    unsigned int* index = &indices[0];
+    unsigned int* lineIndex = &lineIndices[0];
+
+    // compute face normals of all quads, then normalize them at once
+    std::vector<float> faceNormals = getFaceNormals(&tmpVertices[0].x, sizeof(Vertex) / sizeof(float));
 
     // v2-v4 <== stack at i+1
     // | \ |
@@ -469,131 +672,75 @@ void Cylinder::buildVerticesFlat()
             v3 = tmpVertices[vi1 + 1];
             v4 = tmpVertices[vi2 + 1];
 
-            // compute a face normal of v1-v3-v2
-            n = computeFaceNormal(v1.x,v1.y,v1.z, v3.x,v3.y,v3.z, v2.x,v2.y,v2.z);
+            // face normal of v1-v3-v2
+            n = &faceNormals[(i * sectorCount + j) * 3];
 
-            // put quad vertices: v1-v2-v3-v4
-            addVertex(v1.x, v1.y, v1.z);
-            addVertex(v2.x, v2.y, v2.z);
-            addVertex(v3.x, v3.y, v3.z);
-            addVertex(v4.x, v4.y, v4.z);
-
-            // put tex coords of quad
-            addTexCoord(v1.s, v1.t);
-            addTexCoord(v2.s, v2.t);
-            addTexCoord(v3.s, v3.t);
-            addTexCoord(v4.s, v4.t);
-
-            // put normal
-            for(k = 0; k < 4; ++k)  // same normals for all 4 vertices
-            {
-                addNormal(n[0], n[1], n[2]);
-            }
+            // put quad vertices: v1-v2-v3-v4 with same normals for all 4 vertices
+            setVertex(vertexIndex,     v1.x, v1.y, v1.z, n[0], n[1], n[2], v1.s, v1.t);
+            setVertex(vertexIndex + 1, v2.x, v2.y, v2.z, n[0], n[1], n[2], v2.s, v2.t);
+            setVertex(vertexIndex + 2, v3.x, v3.y, v3.z, n[0], n[1], n[2], v3.s, v3.t);
+            setVertex(vertexIndex + 3, v4.x, v4.y, v4.z, n[0], n[1], n[2], v4.s, v4.t);
 
             // put indices of a quad
-            addIndices(index,   index+2, index+1);    // v1-v3-v2
-            addIndices(index+1, index+2, index+3);    // v2-v3-v4
+            index = putIndices(index, vertexIndex,   vertexIndex+2, vertexIndex+1);    // v1-v3-v2
+            index = putIndices(index, vertexIndex+1, vertexIndex+2, vertexIndex+3);    // v2-v3-v4
 
             // vertical line per quad: v1-v2
-            lineIndices.push_back(index);
-            lineIndices.push_back(index+1);
+            lineIndex = putLine(lineIndex, vertexIndex, vertexIndex+1);
             // horizontal line per quad: v2-v4
-            lineIndices.push_back(index+1);
-            lineIndices.push_back(index+3);
+            lineIndex = putLine(lineIndex, vertexIndex+1, vertexIndex+3);
             if(i == 0)
-            {
-                lineIndices.push_back(index);
-                lineIndices.push_back(index+2);
-            }
+                lineIndex = putLine(lineIndex, vertexIndex, vertexIndex+2);
 
-            index += 4;     // for next
+            vertexIndex += 4;   // for next
         }
     }
 
     // remember where the base index starts
-    baseIndex = (unsigned int)indices.size();
-    unsigned int baseVertexIndex = (unsigned int)vertices.size() / 3;
+    baseIndex = (unsigned int)(index - &indices[0]);
+    unsigned int baseVertexIndex = vertexIndex;
 
     // put vertices of base of cylinder
-    z = -height * 0.5f;
-    addVertex(0, 0, z);
-    addNormal(0, 0, -1);
-    addTexCoord(0.5f, 0.5f);
+    z = -meshHeight * 0.5f;
+    setVertex(vertexIndex++, 0, 0, z, 0, 0, -1, 0.5f, 0.5f);
     for(i = 0, j = 0; i < sectorCount; ++i, j += 3)
     {
         x = unitCircleVertices[j];
         y = unitCircleVertices[j+1];
-        addVertex(x * baseRadius, y * baseRadius, z);
-        addNormal(0, 0, -1);
-        addTexCoord(-x * 0.5f + 0.5f, -y * 0.5f + 0.5f); // flip horizontal
+        setVertex(vertexIndex++, x * meshBaseRadius, y * meshBaseRadius, z, 0, 0, -1,
+                  -x * 0.5f + 0.5f, -y * 0.5f + 0.5f);      // flip horizontal
     }
 
     // put indices for base
     for(i = 0, k = baseVertexIndex + 1; i < sectorCount; ++i, ++k)
     {
         if(i < sectorCount - 1)
-            addIndices(baseVertexIndex, k + 1, k);
+            index = putIndices(index, baseVertexIndex, k + 1, k);
         else
-            addIndices(baseVertexIndex, baseVertexIndex + 1, k);
+            index = putIndices(index, baseVertexIndex, baseVertexIndex + 1, k);
     }
 
     // remember where the top index starts
-    topIndex = (unsigned int)indices.size();
-    unsigned int topVertexIndex = (unsigned int)vertices.size() / 3;
+    topIndex = (unsigned int)(index - &indices[0]);
+    unsigned int topVertexIndex = vertexIndex;
 
     // put vertices of top of cylinder
-    z = height * 0.5f;
-    addVertex(0, 0, z);
-    addNormal(0, 0, 1);
-    addTexCoord(0.5f, 0.5f);
+    z = meshHeight * 0.5f;
+    setVertex(vertexIndex++, 0, 0, z, 0, 0, 1, 0.5f, 0.5f);
     for(i = 0, j = 0; i < sectorCount; ++i, j += 3)
     {
         x = unitCircleVertices[j];
         y = unitCircleVertices[j+1];
-        addVertex(x * topRadius, y * topRadius, z);
-        addNormal(0, 0, 1);
-        addTexCoord(x * 0.5f + 0.5f, -y * 0.5f + 0.5f);
+        setVertex(vertexIndex++, x * meshTopRadius, y * meshTopRadius, z, 0, 0, 1,
+                  x * 0.5f + 0.5f, -y * 0.5f + 0.5f);
     }
 
     for(i = 0, k = topVertexIndex + 1; i < sectorCount; ++i, ++k)
     {
         if(i < sectorCount - 1)
-            addIndices(topVertexIndex, k, k + 1);
+            index = putIndices(index, topVertexIndex, k, k + 1);
         else
-            addIndices(topVertexIndex, k, topVertexIndex + 1);
-    }
-
-    // generate interleaved vertex array as well
-    buildInterleavedVertices();
-}
-
-
-
-///////////////////////////////////////////////////////////////////////////////
-// generate interleaved vertices: V/N/T
-// stride must be 32 bytes
-///////////////////////////////////////////////////////////////////////////////
-void Cylinder::buildInterleavedVertices()
-{
-    std::vector<float>().swap(interleavedVertices);
-
-    std::size_t i, j;
-    std::size_t count = vertices.size();
-    for(i = 0, j = 0; i < count; i += 3, j += 2)
-    {
-        //interleavedVertices.push_back(vertices[i]);
-        //interleavedVertices.push_back(vertices[i+1]);
-        //interleavedVertices.push_back(vertices[i+2]);
-        interleavedVertices.insert(interleavedVertices.end(), &vertices[i], &vertices[i] + 3);
-
-        //interleavedVertices.push_back(normals[i]);
-        //interleavedVertices.push_back(normals[i+1]);
-        //interleavedVertices.push_back(normals[i+2]);
-        interleavedVertices.insert(interleavedVertices.end(), &normals[i], &normals[i] + 3);
-
-        //interleavedVertices.push_back(texCoords[j]);
-        //interleavedVertices.push_back(texCoords[j+1]);
-        interleavedVertices.insert(interleavedVertices.end(), &texCoords[j], &texCoords[j] + 2);
+            index = putIndices(index, topVertexIndex, k, topVertexIndex + 1);
     }
 }
 
@@ -604,7 +751,6 @@ void Cylinder::buildInterleavedVertices()
 ///////////////////////////////////////////////////////////////////////////////
 void Cylinder::buildUnitCircleVertices()
 {
-    const float PI = acos(-1);
     float sectorStep = 2 * PI / sectorCount;
     float sectorAngle;  // radian
 
@@ -621,48 +767,85 @@ void Cylinder::buildUnitCircleVertices()
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// add single vertex to array
+// quantize the interleaved vertices to the compact vertices, and release the
+// float arrays
+// position: snorm16 of (x/r, y/r, z/(h/2)), r is the max radius
+// normal  : snorm8 of normalize(r*nx, r*ny, (h/2)*nz), so the inverse-transpose
+//           of the position scale (r, r, h/2) gives the normal back
+// texCoord: [0, 1] to [0, 32767]
+// indices : 16-bit if # of vertices <= 65536, otherwise 32-bit
 ///////////////////////////////////////////////////////////////////////////////
-void Cylinder::addVertex(float x, float y, float z)
+void Cylinder::buildCompactVertices()
 {
-    vertices.push_back(x);
-    vertices.push_back(y);
-    vertices.push_back(z);
-}
-
+    float radius = std::max(fabsf(meshBaseRadius), fabsf(meshTopRadius));
+    float halfHeight = fabsf(meshHeight) * 0.5f;
+    if(radius == 0)
+        radius = 1;
+    if(halfHeight == 0)
+        halfHeight = 1;
+    compactScale[0] = compactScale[1] = radius / COMPACT_POSITION_SCALE;
+    compactScale[2] = halfHeight / COMPACT_POSITION_SCALE;
+
+    float invRadius = 1.0f / radius;
+    float invHalfHeight = 1.0f / halfHeight;
+    compactVertices.resize(vertexCount);
+    const float* v = interleavedVertices.data();
+    for(unsigned int i = 0; i < vertexCount; ++i, v += INTERLEAVED_FLOAT_COUNT)
+    {
+        CompactVertex& c = compactVertices[i];
+        c.x  = (short)quantize(v[0] * invRadius, -1, COMPACT_POSITION_SCALE);
+        c.y  = (short)quantize(v[1] * invRadius, -1, COMPACT_POSITION_SCALE);
+        c.z  = (short)quantize(v[2] * invHalfHeight, -1, COMPACT_POSITION_SCALE);
+        c.w  = 0;
+        float nx = v[3] * radius;
+        float ny = v[4] * radius;
+        float nz = v[5] * halfHeight;
+        float invLength = 1.0f / sqrtf(nx * nx + ny * ny + nz * nz);
+        c.nx = (signed char)quantize(nx * invLength, -1, COMPACT_NORMAL_SCALE);
+        c.ny = (signed char)quantize(ny * invLength, -1, COMPACT_NORMAL_SCALE);
+        c.nz = (signed char)quantize(nz * invLength, -1, COMPACT_NORMAL_SCALE);
+        c.nw = 0;
+        c.s  = (short)quantize(v[6], 0, COMPACT_TEXCOORD_SCALE);
+        c.t  = (short)quantize(v[7], 0, COMPACT_TEXCOORD_SCALE);
+    }
 
+    if(vertexCount <= MAX_COMPACT_VERTEX_COUNT)
+    {
+        compactIndices.assign(indices.begin(), indices.end());
+        compactLineIndices.assign(lineIndices.begin(), lineIndices.end());
+        std::vector<unsigned int>().swap(indices);
+        std::vector<unsigned int>().swap(lineIndices);
+    }
 
-///////////////////////////////////////////////////////////////////////////////
-// add single normal to array
-///////////////////////////////////////////////////////////////////////////////
-void Cylinder::addNormal(float nx, float ny, float nz)
-{
-    normals.push_back(nx);
-    normals.push_back(ny);
-    normals.push_back(nz);
+    std::vector<float>().swap(interleavedVertices);
+    std::vector<float>().swap(vertices);
+    std::vector<float>().swap(normals);
+    std::vector<float>().swap(texCoords);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// add single texture coord to array
+// write a vertex (position, normal, tex coord) at index to the interleaved
+// array, and to the separate arrays if enabled
 ///////////////////////////////////////////////////////////////////////////////
-void Cylinder::addTexCoord(float s, float t)
+void Cylinder::setVertex(unsigned int index, float x, float y, float z,
+                         float nx, float ny, float nz, float s, float t)
 {
-    texCoords.push_back(s);
-    texCoords.push_back(t);
-}
-
+    float* v = &interleavedVertices[index * INTERLEAVED_FLOAT_COUNT];
+    v[0] = x;   v[1] = y;   v[2] = z;
+    v[3] = nx;  v[4] = ny;  v[5] = nz;
+    v[6] = s;   v[7] = t;
 
-
-///////////////////////////////////////////////////////////////////////////////
-// add 3 indices to array
-///////////////////////////////////////////////////////////////////////////////
-void Cylinder::addIndices(unsigned int i1, unsigned int i2, unsigned int i3)
-{
-    indices.push_back(i1);
-    indices.push_back(i2);
-    indices.push_back(i3);
+    if(separateArrays)
+    {
+        float* p = &vertices[index * 3];
+        p[0] = x;   p[1] = y;   p[2] = z;
+        float* n = &normals[index * 3];
+        n[0] = nx;  n[1] = ny;  n[2] = nz;
+        float* c = &texCoords[index * 2];
+        c[0] = s;   c[1] = t;
+    }
 }
 
 
@@ -672,13 +855,12 @@ void Cylinder::addIndices(unsigned int i1, unsigned int i2, unsigned int i3)
 ///////////////////////////////////////////////////////////////////////////////
 std::vector<float> Cylinder::getSideNormals()
 {
-    const float PI = acos(-1);
     float sectorStep = 2 * PI / sectorCount;
     float sectorAngle;  // radian
 
     // compute the normal vector at 0 degree first
-    // tanA = (baseRadius-topRadius) / height
-    float zAngle = atan2(baseRadius - topRadius, height);
+    // tanA = (meshBaseRadius-meshTopRadius) / meshHeight
+    float zAngle = atan2(meshBaseRadius - meshTopRadius, meshHeight);
     float x0 = cos(zAngle);     // nx
     float y0 = 0;               // ny
     float z0 = sin(zAngle);     // nz
@@ -706,41 +888,39 @@ std::vector<float> Cylinder::getSideNormals()
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// return face normal of a triangle v1-v2-v3
-// if a triangle has no surface (normal length = 0), then return a zero vector
+// return face normals of the side quads, (stackCount * sectorCount) normals
+// The vertices are the (sectorCount+1) x (stackCount+1) grid of the side, and
+// stride is the number of floats to the next vertex. The normal of a quad is
+// the cross product of v1-v3-v2, and all normals are normalized at once.
+// If a triangle has no surface (normal length = 0), its normal is a zero vector.
 ///////////////////////////////////////////////////////////////////////////////
-std::vector<float> Cylinder::computeFaceNormal(float x1, float y1, float z1,  // v1
-                                               float x2, float y2, float z2,  // v2
-                                               float x3, float y3, float z3)  // v3
+std::vector<float> Cylinder::getFaceNormals(const float* vertices, int stride)
 {
-    const float EPSILON = 0.000001f;
-
-    std::vector<float> normal(3, 0.0f);     // default return value (0,0,0)
-    float nx, ny, nz;
-
-    // find 2 edge vectors: v1-v2, v1-v3
-    float ex1 = x2 - x1;
-    float ey1 = y2 - y1;
-    float ez1 = z2 - z1;
-    float ex2 = x3 - x1;
-    float ey2 = y3 - y1;
-    float ez2 = z3 - z1;
-
-    // cross product: e1 x e2
-    nx = ey1 * ez2 - ez1 * ey2;
-    ny = ez1 * ex2 - ex1 * ez2;
-    nz = ex1 * ey2 - ey1 * ex2;
-
-    // normalize only if the length is > 0
-    float length = sqrtf(nx * nx + ny * ny + nz * nz);
-    if(length > EPSILON)
+    std::vector<float> normals(stackCount * sectorCount * 3);
+    float* n = &normals[0];
+    for(int i = 0; i < stackCount; ++i)
     {
-        // normalize
-        float lengthInv = 1.0f / length;
-        normal[0] = nx * lengthInv;
-        normal[1] = ny * lengthInv;
-        normal[2] = nz * lengthInv;
+        const float* v1 = vertices + i * (sectorCount + 1) * stride;    // stack at i
+        const float* v2 = v1 + (sectorCount + 1) * stride;              // stack at i+1
+        for(int j = 0; j < sectorCount; ++j, v1 += stride, v2 += stride, n += 3)
+        {
+            const float* v3 = v1 + stride;
+
+            // find 2 edge vectors: v1-v3, v1-v2
+            float ex1 = v3[0] - v1[0];
+            float ey1 = v3[1] - v1[1];
+            float ez1 = v3[2] - v1[2];
+            float ex2 = v2[0] - v1[0];
+            float ey2 = v2[1] - v1[1];
+            float ez2 = v2[2] - v1[2];
+
+            // cross product: e1 x e2
+            n[0] = ey1 * ez2 - ez1 * ey2;
+            n[1] = ez1 * ex2 - ex1 * ez2;
+            n[2] = ex1 * ey2 - ey1 * ex2;
+        }
     }
 
-    return normal;
+    normalizeVectors(&normals[0], stackCount * sectorCount, &normals[0], SQRT_EXACT);
+    return normals;
 }
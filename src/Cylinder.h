@@ -9,19 +9,56 @@
 // - sectors    : the number of slices of the base and top caps
 // - stacks     : the number of subdivisions along z-axis
 //
+// The vertex and index counts are known from sectors and stacks, so the
+// arrays are allocated once and the vertices are written to the interleaved
+// array (and the separate arrays if enabled) in a single pass.
+//
+// In instanced mode, the mesh is the unit cylinder of the taper ratio
+// (max radius = 1, height = 1), and draw() scales it with the transform of
+// getTransform(). Changing the radius or height keeps the mesh and updates
+// the transform only, unless the taper ratio changes. So a single instanced
+// Cylinder can draw any number of different-sized cylinders by calling
+// set() before each draw(). getVertices() returns the unit mesh.
+//
+// In compact mode, the vertices are stored in 16 bytes (CompactVertex) with
+// 16-bit indices instead of 32 bytes with 32-bit indices. The positions are
+// scaled to the bounds of the cylinder, and draw() scales them back with the
+// modelview matrix (getCompactScale()). The normals are pre-scaled by the
+// same scale, so they are correct after the inverse-transpose of the
+// modelview matrix (and GL_NORMALIZE). The float arrays are released, so
+// getVertices()/getNormals()/getTexCoords()/getInterleavedVertices() return
+// empty arrays, and getIndices() too if 16-bit indices are used.
+//
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2018-03-27
-// UPDATED: 2019-12-02
+// UPDATED: 2026-10-17
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef GEOMETRY_CYLINDER_H
 #define GEOMETRY_CYLINDER_H
 
+#include <cstddef>
 #include <vector>
 
 class Cylinder
 {
 public:
+    // 16-byte vertex of compact mode
+    // position: snorm16 scaled to the bounds, w is padding
+    // normal  : snorm8 of the normal scaled by getCompactScale(), nw is padding
+    // texCoord: [0, 1] scaled to [0, 32767]
+    // The normal is 3 x snorm8 because glNormalPointer() of the fixed-function
+    // pipeline cannot decode a 2-byte octahedral normal (which would pack the
+    // vertex to 12 bytes). w aligns the normal at offset 8 and nw aligns the
+    // texCoord at offset 12, because GL drivers expect each attribute and the
+    // stride at 4-byte boundaries.
+    struct CompactVertex
+    {
+        short x, y, z, w;
+        signed char nx, ny, nz, nw;
+        short s, t;
+    };
+
     // ctor/dtor
     Cylinder(float baseRadius=1.0f, float topRadius=1.0f, float height=1.0f,
              int sectorCount=36, int stackCount=1, bool smooth=true);
@@ -41,13 +78,20 @@ public:
     void setSectorCount(int sectorCount);
     void setStackCount(int stackCount);
     void setSmooth(bool smooth);
+    void setSeparateArrays(bool enable);    // build vertex/normal/texCoord arrays, default true
+    bool hasSeparateArrays() const          { return separateArrays; }
+    void setInstanced(bool enable);         // build unit mesh and scale it with transform, default false
+    bool isInstanced() const                { return instanced; }
+    const float* getTransform() const       { return transform; }   // 4x4 column-major, identity if not instanced
+    void setCompact(bool enable);           // 16-byte vertices and 16-bit indices, default false
+    bool isCompact() const                  { return compact; }
 
     // for vertex data
-    unsigned int getVertexCount() const     { return (unsigned int)vertices.size() / 3; }
+    unsigned int getVertexCount() const     { return vertexCount; }
     unsigned int getNormalCount() const     { return (unsigned int)normals.size() / 3; }
     unsigned int getTexCoordCount() const   { return (unsigned int)texCoords.size() / 2; }
-    unsigned int getIndexCount() const      { return (unsigned int)indices.size(); }
-    unsigned int getLineIndexCount() const  { return (unsigned int)lineIndices.size(); }
+    unsigned int getIndexCount() const      { return indexCount; }
+    unsigned int getLineIndexCount() const  { return lineIndexCount; }
     unsigned int getTriangleCount() const   { return getIndexCount() / 3; }
     unsigned int getVertexSize() const      { return (unsigned int)vertices.size() * sizeof(float); }
     unsigned int getNormalSize() const      { return (unsigned int)normals.size() * sizeof(float); }
@@ -64,11 +108,20 @@ public:
     unsigned int getInterleavedVertexCount() const  { return getVertexCount(); }    // # of vertices
     unsigned int getInterleavedVertexSize() const   { return (unsigned int)interleavedVertices.size() * sizeof(unsigned int); }    // # of bytes
     int getInterleavedStride() const                { return interleavedStride; }   // should be 32 bytes
-    const float* getInterleavedVertices() const     { return &interleavedVertices[0]; }
+    const float* getInterleavedVertices() const     { return interleavedVertices.data(); }
+
+    // for compact vertices
+    const CompactVertex* getCompactVertices() const { return compactVertices.data(); }
+    unsigned int getCompactVertexSize() const       { return (unsigned int)compactVertices.size() * sizeof(CompactVertex); }
+    const float* getCompactScale() const            { return compactScale; }    // position = (x,y,z) * scale
+    bool hasCompactIndices() const                  { return !compactIndices.empty(); }    // 16-bit indices
+    const unsigned short* getCompactIndices() const { return compactIndices.data(); }
+    const unsigned short* getCompactLineIndices() const { return compactLineIndices.data(); }
+    unsigned int getCompactIndexSize() const        { return (unsigned int)compactIndices.size() * sizeof(unsigned short); }
 
     // for indices of base/top/side parts
-    unsigned int getBaseIndexCount() const  { return ((unsigned int)indices.size() - baseIndex) / 2; }
-    unsigned int getTopIndexCount() const   { return ((unsigned int)indices.size() - baseIndex) / 2; }
+    unsigned int getBaseIndexCount() const  { return (indexCount - baseIndex) / 2; }
+    unsigned int getTopIndexCount() const   { return (indexCount - baseIndex) / 2; }
     unsigned int getSideIndexCount() const  { return baseIndex; }
     unsigned int getBaseStartIndex() const  { return baseIndex; }
     unsigned int getTopStartIndex() const   { return topIndex; }
@@ -90,18 +143,19 @@ protected:
 private:
     // member functions
     void clearArrays();
+    void buildVertices();
     void buildVerticesSmooth();
     void buildVerticesFlat();
-    void buildInterleavedVertices();
+    void buildCompactVertices();
+    void resizeArrays(unsigned int vertexCount, unsigned int indexCount, unsigned int lineIndexCount);
     void buildUnitCircleVertices();
-    void addVertex(float x, float y, float z);
-    void addNormal(float x, float y, float z);
-    void addTexCoord(float s, float t);
-    void addIndices(unsigned int i1, unsigned int i2, unsigned int i3);
+    void setVertex(unsigned int index, float x, float y, float z,
+                   float nx, float ny, float nz, float s, float t);
     std::vector<float> getSideNormals();
-    std::vector<float> computeFaceNormal(float x1, float y1, float z1,
-                                         float x2, float y2, float z2,
-                                         float x3, float y3, float z3);
+    std::vector<float> getFaceNormals(const float* vertices, int stride);
+    bool beginDraw(bool positionOnly) const;
+    void endDraw(bool normalize, bool positionOnly) const;
+    void drawTriangles(unsigned int first, unsigned int count) const;
 
     // memeber vars
     float baseRadius;
@@ -109,9 +163,19 @@ private:
     float height;
     int sectorCount;                        // # of slices
     int stackCount;                         // # of stacks
+    unsigned int vertexCount;
+    unsigned int indexCount;
+    unsigned int lineIndexCount;
     unsigned int baseIndex;                 // starting index of base
     unsigned int topIndex;                  // starting index of top
     bool smooth;
+    bool separateArrays;                    // vertices, normals and texCoords
+    bool instanced;                         // unit mesh scaled by transform
+    bool compact;                           // CompactVertex and 16-bit indices
+    float meshBaseRadius;                   // size of the built mesh, same as
+    float meshTopRadius;                    // baseRadius/topRadius/height if
+    float meshHeight;                       // not instanced
+    float transform[16];                    // scale of the unit mesh, column-major
     std::vector<float> unitCircleVertices;
     std::vector<float> vertices;
     std::vector<float> normals;
@@ -123,6 +187,16 @@ private:
     std::vector<float> interleavedVertices;
     int interleavedStride;                  // # of bytes to hop to the next vertex (should be 32 bytes)
 
+    // compact
+    std::vector<CompactVertex> compactVertices;
+    std::vector<unsigned short> compactIndices;
+    std::vector<unsigned short> compactLineIndices;
+    float compactScale[3];                  // position scale of x, y, z
+
 };
 
+static_assert(sizeof(Cylinder::CompactVertex) == 16, "CompactVertex must be 16 bytes");
+static_assert(offsetof(Cylinder::CompactVertex, nx) == 8, "normal must be at 4-byte boundary");
+static_assert(offsetof(Cylinder::CompactVertex, s) == 12, "texCoord must be at 4-byte boundary");
+
 #endif
@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////
+// CylinderCache.cpp
+// =================
+// cache of shared cylinder meshes keyed by the parameters
+//
+// Dependencies: Cylinder, C++11 <memory> <future>
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include "CylinderCache.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+CylinderCache::CylinderCache(int capacity) : hitCount(0), missCount(0), evictionCount(0),
+                                             buildCount(0)
+{
+    this->capacity = (capacity > 0) ? capacity : 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare keys for std::map, member by member
+///////////////////////////////////////////////////////////////////////////////
+bool CylinderCache::Key::operator<(const Key& rhs) const
+{
+    if(baseRadius != rhs.baseRadius)    return baseRadius < rhs.baseRadius;
+    if(topRadius != rhs.topRadius)      return topRadius < rhs.topRadius;
+    if(height != rhs.height)            return height < rhs.height;
+    if(sectorCount != rhs.sectorCount)  return sectorCount < rhs.sectorCount;
+    if(stackCount != rhs.stackCount)    return stackCount < rhs.stackCount;
+    return smooth < rhs.smooth;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the cached mesh and move it to the front of LRU list, or build a new
+// mesh and cache it
+// A miss inserts a pending entry under the lock and builds the mesh after
+// unlocking, so the other keys are not blocked by the build. A hit on a
+// pending entry waits for its build.
+///////////////////////////////////////////////////////////////////////////////
+CylinderCache::CylinderPtr CylinderCache::get(float baseRadius, float topRadius, float height,
+                                              int sectorCount, int stackCount, bool smooth)
+{
+    Key key = { baseRadius, topRadius, height, sectorCount, stackCount, smooth };
+    std::promise<CylinderPtr> promise;
+    std::shared_future<CylinderPtr> pending;
+    unsigned int buildId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<Key, Entry>::iterator it = entries.find(key);
+        if(it != entries.end())
+        {
+            ++hitCount;
+            lruKeys.splice(lruKeys.begin(), lruKeys, it->second.lruPosition);
+            if(it->second.cylinder)
+                return it->second.cylinder;
+            pending = it->second.pending;   // being built by another thread
+        }
+        else
+        {
+            ++missCount;
+            Entry entry;
+            entry.pending = promise.get_future().share();
+            entry.buildId = buildId = ++buildCount;
+            lruKeys.push_front(key);
+            entry.lruPosition = lruKeys.begin();
+            entries[key] = entry;
+            evict();
+        }
+    }
+
+    // wait for the other thread outside of the lock
+    if(pending.valid())
+        return pending.get();
+
+    // build outside of the lock
+    CylinderPtr cylinder;
+    try
+    {
+        cylinder = std::make_shared<const Cylinder>(baseRadius, topRadius, height,
+                                                    sectorCount, stackCount, smooth);
+    }
+    catch(...)
+    {
+        erase(key, buildId);
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    // store it unless the entry was dropped (clear()) while it was built
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<Key, Entry>::iterator it = entries.find(key);
+        if(it != entries.end() && it->second.buildId == buildId)
+        {
+            it->second.cylinder = cylinder;
+            it->second.pending = std::shared_future<CylinderPtr>();
+            evict();
+        }
+    }
+    promise.set_value(cylinder);
+    return cylinder;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// drop the pending entry of a failed build
+///////////////////////////////////////////////////////////////////////////////
+void CylinderCache::erase(const Key& key, unsigned int buildId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<Key, Entry>::iterator it = entries.find(key);
+    if(it != entries.end() && it->second.buildId == buildId)
+    {
+        lruKeys.erase(it->second.lruPosition);
+        entries.erase(it);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the max # of cached meshes, and evict the old ones if over
+///////////////////////////////////////////////////////////////////////////////
+void CylinderCache::setCapacity(int capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    this->capacity = (capacity > 0) ? capacity : 0;
+    evict();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// drop meshes from the least recently used while size > capacity
+// The meshes in use or being built are skipped. The caller must hold the lock.
+///////////////////////////////////////////////////////////////////////////////
+void CylinderCache::evict()
+{
+    std::list<Key>::iterator it = lruKeys.end();
+    while((int)entries.size() > capacity && it != lruKeys.begin())
+    {
+        --it;
+        std::map<Key, Entry>::iterator entry = entries.find(*it);
+        if(!entry->second.cylinder || entry->second.cylinder.use_count() > 1)
+            continue;       // being built or in use, keep it
+
+        entries.erase(entry);
+        it = lruKeys.erase(it);
+        ++evictionCount;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// drop all meshes, the meshes in use are still valid for their users
+///////////////////////////////////////////////////////////////////////////////
+void CylinderCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    evictionCount += (unsigned int)entries.size();
+    entries.clear();
+    lruKeys.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// drop the meshes not in use
+///////////////////////////////////////////////////////////////////////////////
+void CylinderCache::purge()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    int savedCapacity = capacity;
+    capacity = 0;
+    evict();
+    capacity = savedCapacity;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// getters of size and statistics
+///////////////////////////////////////////////////////////////////////////////
+int CylinderCache::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (int)entries.size();
+}
+
+unsigned int CylinderCache::getHitCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hitCount;
+}
+
+unsigned int CylinderCache::getMissCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return missCount;
+}
+
+unsigned int CylinderCache::getEvictionCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return evictionCount;
+}
+
+void CylinderCache::resetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    hitCount = missCount = evictionCount = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print itself
+///////////////////////////////////////////////////////////////////////////////
+void CylinderCache::printSelf() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    unsigned int lookupCount = hitCount + missCount;
+    std::cout << "===== CylinderCache =====\n"
+              << "      Capacity: " << capacity << "\n"
+              << "          Size: " << entries.size() << "\n"
+              << "     Hit Count: " << hitCount << "\n"
+              << "    Miss Count: " << missCount << "\n"
+              << "Eviction Count: " << evictionCount << "\n"
+              << "      Hit Rate: " << (lookupCount ? 100.0 * hitCount / lookupCount : 0.0) << "%"
+              << std::endl;
+}
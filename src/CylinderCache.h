@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// CylinderCache.h
+// ===============
+// cache of shared cylinder meshes keyed by the parameters
+// (base radius, top radius, height, sectors, stacks, smooth)
+// get() returns the same immutable Cylinder for the same parameters, so a
+// scene with many identical cylinders builds and stores the mesh only once.
+//
+// NOTE:
+// 1. The mesh is reference-counted (std::shared_ptr<const Cylinder>), and it
+//    stays valid while it is used even if the cache drops it.
+// 2. Eviction: least recently used first, when the # of cached meshes is
+//    over the capacity. The meshes in use (referenced outside the cache) are
+//    not evicted, so the cache can hold more than the capacity for a while.
+// 3. The keys are the exact parameter values, e.g. sectors 2 and 3 are
+//    different keys even though Cylinder clamps both to 3.
+// 4. It is thread-safe. A miss inserts a pending entry (a shared future of
+//    the mesh) under the lock, and builds the mesh outside of the lock. The
+//    other threads asking for the same mesh wait for the future instead of
+//    building it again, and the lookups of the other keys do not wait. If the
+//    build throws, the entry is removed and the waiters get the exception.
+//
+// Dependencies: Cylinder, C++11 <memory> <future>
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYLINDER_CACHE_H_DEF
+#define CYLINDER_CACHE_H_DEF
+
+#include <list>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "Cylinder.h"
+
+class CylinderCache
+{
+public:
+    typedef std::shared_ptr<const Cylinder> CylinderPtr;
+
+    // ctor/dtor
+    CylinderCache(int capacity=64);
+    ~CylinderCache() {}
+
+    // return the shared mesh of the parameters, build it if not cached
+    CylinderPtr get(float baseRadius, float topRadius, float height,
+                    int sectorCount, int stackCount, bool smooth=true);
+
+    // setters/getters
+    void setCapacity(int capacity);         // max # of cached meshes, evict if over
+    int getCapacity() const                 { return capacity; }
+    int getSize() const;                    // # of cached meshes
+    void clear();                           // drop all meshes
+    void purge();                           // drop the meshes not in use
+
+    // statistics
+    unsigned int getHitCount() const;
+    unsigned int getMissCount() const;
+    unsigned int getEvictionCount() const;
+    void resetStats();
+
+    // debug
+    void printSelf() const;
+
+protected:
+
+private:
+    struct Key
+    {
+        float baseRadius;
+        float topRadius;
+        float height;
+        int sectorCount;
+        int stackCount;
+        bool smooth;
+
+        bool operator<(const Key& rhs) const;
+    };
+    struct Entry
+    {
+        CylinderPtr cylinder;                   // NULL while it is built
+        std::shared_future<CylinderPtr> pending;    // valid while it is built
+        unsigned int buildId;                   // to find the entry after the build
+        std::list<Key>::iterator lruPosition;   // position in lruKeys
+    };
+
+    void evict();                           // drop LRU meshes not in use until size <= capacity
+    void erase(const Key& key, unsigned int buildId);   // drop the entry of a failed build
+
+    // disable copy
+    CylinderCache(const CylinderCache&);
+    CylinderCache& operator=(const CylinderCache&);
+
+    int capacity;
+    std::map<Key, Entry> entries;
+    std::list<Key> lruKeys;                 // most recently used first
+    unsigned int hitCount;
+    unsigned int missCount;
+    unsigned int evictionCount;
+    unsigned int buildCount;                // last buildId
+    mutable std::mutex mutex;
+};
+
+#endif
@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// CylinderLod.cpp
+// ===============
+// level-of-detail set of cylinder meshes
+//
+// Dependencies: Cylinder
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include "CylinderLod.h"
+
+
+
+// constants //////////////////////////////////////////////////////////////////
+const float PI = 3.141593f;
+const int MIN_SECTOR_COUNT = 3;
+const float DEFAULT_TOLERANCE = 4.0f;   // pixels
+const float DEFAULT_HYSTERESIS = 0.2f;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+CylinderLod::CylinderLod(float baseRadius, float topRadius, float height, int sectorCount,
+                         int levelCount, int stackCount, bool smooth)
+    : tolerance(DEFAULT_TOLERANCE), hysteresis(DEFAULT_HYSTERESIS)
+{
+    set(baseRadius, topRadius, height, sectorCount, levelCount, stackCount, smooth);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build the cylinders of the levels, halve the sectors per level
+// It stops at 3 sectors, so the level count can be less than levelCount.
+///////////////////////////////////////////////////////////////////////////////
+void CylinderLod::set(float baseRadius, float topRadius, float height, int sectorCount,
+                      int levelCount, int stackCount, bool smooth)
+{
+    if(sectorCount < MIN_SECTOR_COUNT)
+        sectorCount = MIN_SECTOR_COUNT;
+    if(levelCount < 1)
+        levelCount = 1;
+
+    levels.clear();
+    int sectors = sectorCount;
+    for(int i = 0; i < levelCount; ++i)
+    {
+        levels.push_back(Cylinder(baseRadius, topRadius, height, sectors, stackCount, smooth));
+        if(sectors == MIN_SECTOR_COUNT)
+            break;
+
+        sectors /= 2;
+        if(sectors < MIN_SECTOR_COUNT)
+            sectors = MIN_SECTOR_COUNT;
+    }
+
+    currentLevel = 0;
+    resetStats();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// select the coarsest level whose sector edge is not longer than tolerance
+// It goes finer immediately, but goes coarser only if the edge of the coarser
+// level is shorter than tolerance * (1 - hysteresis).
+///////////////////////////////////////////////////////////////////////////////
+int CylinderLod::selectLevel(float screenSize, int currentLevel) const
+{
+    int lastLevel = (int)levels.size() - 1;
+
+    // edge length of a sector in pixels = circumference / sectors
+    float circumference = screenSize * PI;
+
+    // ideal level without hysteresis
+    int level = lastLevel;
+    while(level > 0 && circumference / levels[level].getSectorCount() > tolerance)
+        --level;
+
+    if(currentLevel < 0 || currentLevel > lastLevel || level <= currentLevel)
+        return level;
+
+    // go coarser only while the coarser level is well under the tolerance
+    float coarserTolerance = tolerance * (1 - hysteresis);
+    while(currentLevel < level &&
+          circumference / levels[currentLevel + 1].getSectorCount() <= coarserTolerance)
+        ++currentLevel;
+    return currentLevel;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw the level selected from the screen size, and keep it for next frame
+///////////////////////////////////////////////////////////////////////////////
+void CylinderLod::draw(float screenSize)
+{
+    currentLevel = selectLevel(screenSize, currentLevel);
+    drawLevel(currentLevel);
+}
+
+void CylinderLod::drawLevel(int level)
+{
+    levels[level].draw();
+
+    ++drawCounts[level];
+    drawnTriangleCount += levels[level].getTriangleCount();
+    fullTriangleCount += levels[0].getTriangleCount();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// projected diameter in pixels of the perspective projection
+// screenSize = 2r / (2 * d * tan(fovY/2)) * screenHeight
+///////////////////////////////////////////////////////////////////////////////
+float CylinderLod::computeScreenSize(float radius, float distance, float fovY, int screenHeight)
+{
+    if(distance <= 0)
+        return (float)screenHeight;     // at or behind the eye, treat as full screen
+
+    float halfFov = fovY * 0.5f * PI / 180.0f;
+    return radius / (distance * tanf(halfFov)) * screenHeight;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// statistics
+///////////////////////////////////////////////////////////////////////////////
+float CylinderLod::getTriangleSavings() const
+{
+    if(fullTriangleCount == 0)
+        return 0;
+    return 1.0f - (float)((double)drawnTriangleCount / fullTriangleCount);
+}
+
+void CylinderLod::resetStats()
+{
+    drawnTriangleCount = fullTriangleCount = 0;
+    drawCounts.assign(levels.size(), 0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print itself
+///////////////////////////////////////////////////////////////////////////////
+void CylinderLod::printSelf() const
+{
+    std::cout << "===== CylinderLod =====\n"
+              << "   Level Count: " << levels.size() << "\n"
+              << "     Tolerance: " << tolerance << " pixels\n"
+              << "    Hysteresis: " << hysteresis << "\n"
+              << " Current Level: " << currentLevel << "\n";
+    for(size_t i = 0; i < levels.size(); ++i)
+    {
+        std::cout << "  Level " << i << ": "
+                  << std::setw(3) << levels[i].getSectorCount() << " sectors, "
+                  << std::setw(6) << levels[i].getTriangleCount() << " triangles, "
+                  << drawCounts[i] << " draws\n";
+    }
+    std::cout << "Triangle Savings: " << getTriangleSavings() * 100 << "% ("
+              << drawnTriangleCount << " / " << fullTriangleCount << ")" << std::endl;
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// CylinderLod.h
+// =============
+// level-of-detail set of cylinder meshes
+// It prebuilds the cylinders of the same size with fewer sectors per level
+// (sectorCount, sectorCount/2, sectorCount/4, ..., min 3 sectors), and draw()
+// selects a level from the projected size of the cylinder on the screen.
+//
+// NOTE:
+// 1. The level is the coarsest one whose sector edge on the screen is not
+//    longer than the tolerance in pixels, setTolerance(), default 4 pixels.
+//    edge = screenSize * PI / sectors (screenSize is the diameter in pixels)
+// 2. Hysteresis: it switches to a finer level as soon as the edge is longer
+//    than the tolerance, but it switches back to a coarser level only if the
+//    edge is shorter than tolerance * (1 - hysteresis). It prevents popping
+//    back and forth at the threshold, setHysteresis(), default 0.2.
+// 3. The statistics count the triangles of the drawn levels and the
+//    triangles if the finest level were drawn, getTriangleSavings().
+// 4. The current level is kept per CylinderLod for the hysteresis. Use
+//    selectLevel() with a level per object to share a CylinderLod.
+//
+// Dependencies: Cylinder
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYLINDER_LOD_H_DEF
+#define CYLINDER_LOD_H_DEF
+
+#include <vector>
+#include "Cylinder.h"
+
+class CylinderLod
+{
+public:
+    // ctor/dtor
+    CylinderLod(float baseRadius=1.0f, float topRadius=1.0f, float height=1.0f,
+                int sectorCount=36, int levelCount=4, int stackCount=1, bool smooth=true);
+    ~CylinderLod() {}
+
+    // setters/getters
+    void set(float baseRadius, float topRadius, float height,
+             int sectorCount, int levelCount, int stackCount, bool smooth=true);
+    void setTolerance(float pixels)         { tolerance = pixels; }
+    void setHysteresis(float ratio)         { hysteresis = ratio; }
+    float getTolerance() const              { return tolerance; }
+    float getHysteresis() const             { return hysteresis; }
+    int getLevelCount() const               { return (int)levels.size(); }
+    int getCurrentLevel() const             { return currentLevel; }
+    const Cylinder& getLevel(int level) const   { return levels[level]; }
+    unsigned int getTriangleCount(int level) const  { return levels[level].getTriangleCount(); }
+
+    // select the level from the projected diameter in pixels
+    int selectLevel(float screenSize, int currentLevel) const;
+
+    // draw the selected level and update the current level and statistics
+    void draw(float screenSize);
+    void drawLevel(int level);
+
+    // projected diameter in pixels of the radius at the distance from the
+    // camera with the vertical field of view (in degree) and screen height
+    static float computeScreenSize(float radius, float distance, float fovY, int screenHeight);
+
+    // statistics
+    unsigned long long getDrawnTriangleCount() const    { return drawnTriangleCount; }
+    unsigned long long getFullTriangleCount() const     { return fullTriangleCount; }
+    float getTriangleSavings() const;       // 1 - drawn / full, [0, 1]
+    unsigned int getDrawCount(int level) const          { return drawCounts[level]; }
+    void resetStats();
+
+    // debug
+    void printSelf() const;
+
+protected:
+
+private:
+    std::vector<Cylinder> levels;           // finest first
+    std::vector<unsigned int> drawCounts;   // # of draws per level
+    float tolerance;                        // max sector edge in pixels
+    float hysteresis;                       // ratio of tolerance to switch to coarser level
+    int currentLevel;
+    unsigned long long drawnTriangleCount;
+    unsigned long long fullTriangleCount;   // as if level 0 were drawn
+};
+
+#endif
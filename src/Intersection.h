@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// Intersection.h
+// ==============
+// status codes and result types of intersection tests
+// The result carries an explicit status next to the geometry instead of a
+// NaN point, so the caller can branch on the status (or skip the branch).
+//
+// NOTE:
+// 1. INTERSECTION_HIT is the only odd status, so (status & INTERSECTION_HIT)
+//    is the hit mask. The batch functions write a status byte per element,
+//    and the array can be used as a compaction mask as is.
+// 2. The geometry of a non-hit result is all zero, and the geometry of a hit
+//    is always finite. If the division overflows (too large inputs), the
+//    status is INTERSECTION_PARALLEL instead of a hit with inf or NaN.
+// 3. The rule of parallel, same for the scalar and the batch functions:
+//    2 directions u and v are parallel if |u x v|^2 <= PARALLEL_EPSILON *
+//    |u|^2 * |v|^2 (sin^2 of the angle), and a line is parallel to a plane if
+//    (N.V)^2 <= PARALLEL_EPSILON * |N|^2 * |V|^2 (see isNearlyZero()).
+//    The value is computed in floating point, so it also catches the inputs
+//    whose denominator rounds to 0 or a subnormal. The exact predicates
+//    (Predicates.h) are not used, an exactly parallel input passes the
+//    tolerance test anyway.
+// 4. The parallel inputs are coincident if:
+//    2 lines   : p2-p1 is parallel to V1 by the rule above
+//    2 planes  : |d2*N1 - d1*N2|^2 <= PARALLEL_EPSILON * (d2^2*|N1|^2 + d1^2*|N2|^2)
+//    line/plane: |N.p + d| <= SINGULAR_EPSILON * (|N.p| + |d|)
+// 5. The batch functions (LineBatch, PlaneBatch) use the same rules in float
+//    (simdIsNearlyZero() in Simd.h). They can differ from the double version
+//    of the scalar functions by rounding only.
+//
+// Dependencies: Vector3, Line
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef INTERSECTION_H_DEF
+#define INTERSECTION_H_DEF
+
+#include <cmath>
+#include <limits>
+#include "Vectors.h"
+
+template<typename T> class LineT;
+
+// 2 directions are parallel if sin^2 of the angle between them is less than it
+const float PARALLEL_EPSILON = 1e-10f;
+
+// a point is on a plane if |N.p + d| / (|N.p| + |d|) is less than it, and
+// 3 planes are singular if |det| / (|N1|*|N2|*|N3|) is less than it
+const float SINGULAR_EPSILON = 0.000001f;
+
+// true if valueSq <= PARALLEL_EPSILON * scaleSq, or valueSq is too small to
+// divide by (0 or subnormal)
+template<typename T>
+inline bool isNearlyZero(T valueSq, T scaleSq)
+{
+    return !(valueSq > PARALLEL_EPSILON * scaleSq) || valueSq < std::numeric_limits<T>::min();
+}
+
+// true if all components are finite (not inf nor NaN)
+template<typename T>
+inline bool isFinite(const Vector3T<T>& v)
+{
+    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+
+enum IntersectionStatus
+{
+    INTERSECTION_NONE       = 0,    // no hit in the range (t out of [tMin, tMax])
+    INTERSECTION_HIT        = 1,    // unique point (or line of 2 planes)
+    INTERSECTION_PARALLEL   = 2,    // parallel, never meet (or no unique point)
+    INTERSECTION_COINCIDENT = 4,    // same line, same plane, or line on plane
+    INTERSECTION_SKEW       = 6     // 2 lines are not parallel, but never meet
+};
+
+// intersection point
+template<typename T>
+struct PointIntersectionT
+{
+    IntersectionStatus status;
+    Vector3T<T> point;
+
+    PointIntersectionT() : status(INTERSECTION_NONE), point(0, 0, 0) {}
+    PointIntersectionT(IntersectionStatus s) : status(s), point(0, 0, 0) {}
+    PointIntersectionT(const Vector3T<T>& p) : status(INTERSECTION_HIT), point(p) {}
+    bool isHit() const                      { return status == INTERSECTION_HIT; }
+};
+
+// intersection line
+template<typename T>
+struct LineIntersectionT
+{
+    IntersectionStatus status;
+    LineT<T> line;
+
+    LineIntersectionT() : status(INTERSECTION_NONE) {}
+    LineIntersectionT(IntersectionStatus s) : status(s) {}
+    LineIntersectionT(const LineT<T>& l) : status(INTERSECTION_HIT), line(l) {}
+    bool isHit() const                      { return status == INTERSECTION_HIT; }
+};
+
+typedef PointIntersectionT<float>  PointIntersection;
+typedef PointIntersectionT<double> PointIntersectiond;
+typedef LineIntersectionT<float>   LineIntersection;
+typedef LineIntersectionT<double>  LineIntersectiond;
+
+#endif
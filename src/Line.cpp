@@ -8,18 +8,21 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2015-12-18
-// UPDATED: 2020-07-17
+// UPDATED: 2026-10-17
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
 #include "Line.h"
 
+// the tolerance of parallel and coplanar tests is in Intersection.h
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // ctor
 // convert 2D slope-intercept form to parametric form
 ///////////////////////////////////////////////////////////////////////////////
-Line::Line(float slope, float intercept)
+template<typename T>
+LineT<T>::LineT(T slope, T intercept)
 {
     set(slope, intercept);
 }
@@ -29,7 +32,8 @@ Line::Line(float slope, float intercept)
 ///////////////////////////////////////////////////////////////////////////////
 // ctor with 2D direction and point
 ///////////////////////////////////////////////////////////////////////////////
-Line::Line(const Vector2& direction, const Vector2& point)
+template<typename T>
+LineT<T>::LineT(const Vector2& direction, const Vector2& point)
 {
     set(direction, point);
 }
@@ -39,24 +43,27 @@ Line::Line(const Vector2& direction, const Vector2& point)
 ///////////////////////////////////////////////////////////////////////////////
 // setters
 ///////////////////////////////////////////////////////////////////////////////
-void Line::set(const Vector3& v, const Vector3& p)
+template<typename T>
+void LineT<T>::set(const Vector3T<T>& v, const Vector3T<T>& p)
 {
     this->direction = v;
     this->point = p;
 }
 
-void Line::set(const Vector2& v, const Vector2& p)
+template<typename T>
+void LineT<T>::set(const Vector2& v, const Vector2& p)
 {
     // convert 2D to 3D
-    this->direction = Vector3(v.x, v.y, 0);
-    this->point = Vector3(p.x, p.y, 0);
+    this->direction = Vector3T<T>(v.x, v.y, 0);
+    this->point = Vector3T<T>(p.x, p.y, 0);
 }
 
-void Line::set(float slope, float intercept)
+template<typename T>
+void LineT<T>::set(T slope, T intercept)
 {
     // convert slope-intercept form (2D) to parametric form (3D)
-    this->direction = Vector3(1, slope, 0);
-    this->point = Vector3(0, intercept, 0);
+    this->direction = Vector3T<T>(1, slope, 0);
+    this->point = Vector3T<T>(0, intercept, 0);
 }
 
 
@@ -64,7 +71,8 @@ void Line::set(float slope, float intercept)
 ///////////////////////////////////////////////////////////////////////////////
 // debug
 ///////////////////////////////////////////////////////////////////////////////
-void Line::printSelf()
+template<typename T>
+void LineT<T>::printSelf()
 {
     std::cout << "Line\n"
               << "====\n"
@@ -88,34 +96,35 @@ void Line::printSelf()
 //        a = (p2-p1)xV2 / (V1xV2)
 //        a = ((p2-p1)xV2).(V1xV2) / (V1xV2).(V1xV2)
 ///////////////////////////////////////////////////////////////////////////////
-Vector3 Line::intersect(const Line& line)
+template<typename T>
+Vector3T<T> LineT<T>::intersect(const LineT<T>& line)
 {
-    const Vector3 v2 = line.getDirection();
-    const Vector3 p2 = line.getPoint();
-    Vector3 result = Vector3(NAN, NAN, NAN);    // default with NaN
-
-    // find v3 = (p2 - p1) x V2
-    Vector3 v3 = (p2 - point).cross(v2);
+    const Vector3T<T> v2 = line.getDirection();
+    const Vector3T<T> p2 = line.getPoint();
+    Vector3T<T> result = Vector3T<T>(NAN, NAN, NAN);    // default with NaN
 
     // find v4 = V1 x V2
-    Vector3 v4 = direction.cross(v2);
+    Vector3T<T> v4 = direction.cross(v2);
 
     // find (V1xV2) . (V1xV2)
-    float dot = v4.dot(v4);
+    T dot = v4.dot(v4);
 
-    // if both V1 and V2 are same direction, return NaN point
-    if(dot == 0)
+    // if both V1 and V2 are (nearly) same direction, return NaN point
+    if(isNearlyZero(dot, direction.dot(direction) * v2.dot(v2)))
         return result;
 
+    // find v3 = (p2 - p1) x V2
+    Vector3T<T> v3 = (p2 - point).cross(v2);
+
     // find a = ((p2-p1)xV2).(V1xV2) / (V1xV2).(V1xV2)
-    float alpha = v3.dot(v4) / dot;
+    T alpha = v3.dot(v4) / dot;
 
     /*
     // if both V1 and V2 are same direction, return NaN point
     if(v4.x == 0 && v4.y == 0 && v4.z == 0)
         return result;
 
-    float alpha = 0;
+    T alpha = 0;
     if(v4.x != 0)
         alpha = v3.x / v4.x;
     else if(v4.y != 0)
@@ -126,8 +135,10 @@ Vector3 Line::intersect(const Line& line)
         return result;
     */
 
-    // find intersect point
-    result = point + (alpha * direction);
+    // find intersect point, NaN if it overflows
+    Vector3T<T> p = mulAdd(alpha, direction, point);
+    if(isFinite(p))
+        result = p;
     return result;
 }
 
@@ -136,12 +147,115 @@ Vector3 Line::intersect(const Line& line)
 ///////////////////////////////////////////////////////////////////////////////
 // determine if it intersects with the other line
 ///////////////////////////////////////////////////////////////////////////////
-bool Line::isIntersected(const Line& line)
+template<typename T>
+bool LineT<T>::isIntersected(const LineT<T>& line)
+{
+    // if 2 lines are same direction, the cross product is (nearly) 0
+    const Vector3T<T>& v2 = line.getDirection();
+    Vector3T<T> n = direction.cross(v2);
+    return !isNearlyZero(n.dot(n), direction.dot(direction) * v2.dot(v2));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the intersection point with the other line, and its status.
+// Unlike intersect(), the point is only computed if 2 lines meet:
+//   parallel  : V1xV2 ~ 0 and (p2-p1)xV1 != 0
+//   coincident: V1xV2 ~ 0 and (p2-p1)xV1 ~ 0
+//   skew      : (p2-p1) is not on the plane of V1 and V2, (p2-p1).(V1xV2) != 0
+//   hit       : a = ((p2-p1)xV2).(V1xV2) / (V1xV2).(V1xV2)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+PointIntersectionT<T> LineT<T>::getIntersection(const LineT<T>& line) const
+{
+    const Vector3T<T>& v2 = line.getDirection();
+    Vector3T<T> w = line.getPoint() - point;
+    Vector3T<T> n = direction.cross(v2);
+    T dot = n.dot(n);
+    T dot1 = direction.dot(direction);
+
+    // nearly parallel (see Intersection.h)
+    if(isNearlyZero(dot, dot1 * v2.dot(v2)))
+    {
+        Vector3T<T> m = w.cross(direction);
+        if(isNearlyZero(m.dot(m), w.dot(w) * dot1))
+            return PointIntersectionT<T>(INTERSECTION_COINCIDENT);
+        else
+            return PointIntersectionT<T>(INTERSECTION_PARALLEL);
+    }
+
+    // (w.n)^2 = |w|^2 * |n|^2 * cos^2, where n = V1 x V2
+    T wn = w.dot(n);
+    if(wn * wn > PARALLEL_EPSILON * w.dot(w) * dot)
+        return PointIntersectionT<T>(INTERSECTION_SKEW);
+
+    T alpha = w.cross(v2).dot(n) / dot;
+    Vector3T<T> p = mulAdd(alpha, direction, point);
+    if(!isFinite(p))
+        return PointIntersectionT<T>(INTERSECTION_PARALLEL);  // overflow
+    return PointIntersectionT<T>(p);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the closest points of this and the other line in one pass.
+// Unlike intersect(), it works for skew lines, and the squared distance
+// between 2 points tells if they really meet (0 if intersected).
+//
+// Line1 = p1 + aV1 (this),  point1 = p1 + aV1
+// Line2 = p2 + bV2 (other), point2 = p2 + bV2
+// The gap (point2 - point1) is perpendicular to both V1 and V2:
+//   a = ((p2-p1)xV2).(V1xV2) / (V1xV2).(V1xV2)
+//   b = ((p2-p1)xV1).(V1xV2) / (V1xV2).(V1xV2)
+// If 2 lines are (nearly) parallel, any point is closest, so a = 0 and point1 = p1 is
+// projected onto the other line: b = (p1-p2).V2 / V2.V2
+// (or b = 0 and a = (p2-p1).V1 / V1.V1 if the other line has no direction)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+T LineT<T>::closestPoints(const LineT<T>& line, T& alpha, T& beta,
+                          Vector3T<T>& point1, Vector3T<T>& point2) const
 {
-    // if 2 lines are same direction, the magnitude of cross product is 0
-    Vector3 v = this->direction.cross(line.getDirection());
-    if(v.x == 0 && v.y == 0 && v.z == 0)
-        return false;
+    const Vector3T<T>& v2 = line.getDirection();
+    const Vector3T<T>& p2 = line.getPoint();
+
+    // w = p2 - p1, n = V1 x V2
+    Vector3T<T> w = p2 - point;
+    Vector3T<T> n = direction.cross(v2);
+    T dot = n.dot(n);
+    T dot1 = direction.dot(direction);
+    T dot2 = v2.dot(v2);
+
+    // |V1xV2|^2 = |V1|^2 * |V2|^2 * sin^2
+    if(!isNearlyZero(dot, dot1 * dot2))
+    {
+        alpha = w.cross(v2).dot(n) / dot;
+        beta = w.cross(direction).dot(n) / dot;
+    }
+    else if(dot2 != 0)
+    {
+        // parallel
+        alpha = 0;
+        beta = -w.dot(v2) / dot2;
+    }
     else
-        return true;
+    {
+        // V2 = 0, the other line is a point
+        alpha = (dot1 != 0) ? w.dot(direction) / dot1 : 0;
+        beta = 0;
+    }
+
+    point1 = mulAdd(alpha, direction, point);
+    point2 = mulAdd(beta, v2, p2);
+    Vector3T<T> gap = point2 - point1;
+    return gap.dot(gap);
 }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// instantiate float and double versions
+///////////////////////////////////////////////////////////////////////////////
+template class LineT<float>;
+template class LineT<double>;
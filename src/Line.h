@@ -4,11 +4,18 @@
 // class to construct a line with parametric form
 // Line = p + aV (a point and a direction vector on the line)
 //
-// Dependency: Vector2, Vector3
+// NOTE:
+// 1. LineT<T> is a template of the element type, float or double. Line is
+//    the float version and Lined is the double version. Both are instantiated
+//    in Line.cpp.
+// 2. getIntersection() returns the point with a status (hit, parallel,
+//    coincident or skew) instead of a NaN point.
+//
+// Dependency: Vector2, Vector3, Intersection
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2015-12-18
-// UPDATED: 2020-07-17
+// UPDATED: 2026-10-17
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef LINE_H_DEF
@@ -16,39 +23,50 @@
 
 #include <cmath>
 #include "Vectors.h"
+#include "Intersection.h"
 
 
 
-class Line
+template<typename T>
+class LineT
 {
 public:
     // ctor/dtor
-    Line() : direction(Vector3(0,0,0)), point(Vector3(0,0,0)) {}
-    Line(const Vector3& v, const Vector3& p) : direction(v), point(p) {}    // with 3D direction and a point
-    Line(const Vector2& v, const Vector2& p);                               // with 2D direction and a point
-    Line(float slope, float intercept);                                     // with 2D slope-intercept form
-    ~Line() {};
+    LineT() : direction(Vector3T<T>(0,0,0)), point(Vector3T<T>(0,0,0)) {}
+    LineT(const Vector3T<T>& v, const Vector3T<T>& p) : direction(v), point(p) {}   // with 3D direction and a point
+    LineT(const Vector2& v, const Vector2& p);                                      // with 2D direction and a point
+    LineT(T slope, T intercept);                                                    // with 2D slope-intercept form
+    ~LineT() {};
 
     // getters/setters
-    void set(const Vector3& v, const Vector3& p);               // from 3D
-    void set(const Vector2& v, const Vector2& p);               // from 2D
-    void set(float slope, float intercept);                     // from slope-intercept form
-    void setPoint(Vector3& p)           { point = p; }
-    void setDirection(const Vector3& v) { direction = v; }
-    const Vector3& getPoint() const     { return point; }
-    const Vector3& getDirection() const { return direction; }
+    void set(const Vector3T<T>& v, const Vector3T<T>& p);   // from 3D
+    void set(const Vector2& v, const Vector2& p);           // from 2D
+    void set(T slope, T intercept);                         // from slope-intercept form
+    void setPoint(Vector3T<T>& p)               { point = p; }
+    void setDirection(const Vector3T<T>& v)     { direction = v; }
+    const Vector3T<T>& getPoint() const         { return point; }
+    const Vector3T<T>& getDirection() const     { return direction; }
     void printSelf();
 
     // find intersect point with other line
-    Vector3 intersect(const Line& line);
-    bool isIntersected(const Line& line);
+    Vector3T<T> intersect(const LineT& line);
+    bool isIntersected(const LineT& line);
+    PointIntersectionT<T> getIntersection(const LineT& line) const; // with status
+
+    // find the closest points of 2 lines (skew, intersected or parallel)
+    // return the squared distance between point1 and point2
+    T closestPoints(const LineT& line, T& alpha, T& beta,
+                    Vector3T<T>& point1, Vector3T<T>& point2) const;
 
 protected:
 
 private:
-    Vector3 direction;
-    Vector3 point;
+    Vector3T<T> direction;
+    Vector3T<T> point;
 };
 
+typedef LineT<float>  Line;
+typedef LineT<double> Lined;
+
 #endif
 
@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////
+// LineBatch.cpp
+// =============
+// a set of 3D lines stored as structure of arrays (SoA) for batch kernels
+// Line = p + aV, each component of V and p is stored in a separate array
+//
+// Dependencies: Line, Plane, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include "LineBatch.h"
+
+// PARALLEL_EPSILON is in Intersection.h, same as Line::closestPoints()
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor with an array of Line
+///////////////////////////////////////////////////////////////////////////////
+LineBatch::LineBatch(const Line* lines, int count)
+{
+    resize(count);
+    for(int i = 0; i < count; ++i)
+        set(i, lines[i]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// resize/reserve/clear all arrays at once
+///////////////////////////////////////////////////////////////////////////////
+void LineBatch::resize(int count)
+{
+    vx.resize(count);  vy.resize(count);  vz.resize(count);
+    px.resize(count);  py.resize(count);  pz.resize(count);
+}
+
+void LineBatch::reserve(int count)
+{
+    vx.reserve(count);  vy.reserve(count);  vz.reserve(count);
+    px.reserve(count);  py.reserve(count);  pz.reserve(count);
+}
+
+void LineBatch::clear()
+{
+    vx.clear();  vy.clear();  vz.clear();
+    px.clear();  py.clear();  pz.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// setters/getters
+///////////////////////////////////////////////////////////////////////////////
+void LineBatch::add(const Line& line)
+{
+    const Vector3& v = line.getDirection();
+    const Vector3& p = line.getPoint();
+    add(v.x, v.y, v.z, p.x, p.y, p.z);
+}
+
+void LineBatch::add(float vx, float vy, float vz, float px, float py, float pz)
+{
+    this->vx.push_back(vx);  this->vy.push_back(vy);  this->vz.push_back(vz);
+    this->px.push_back(px);  this->py.push_back(py);  this->pz.push_back(pz);
+}
+
+void LineBatch::set(int index, const Line& line)
+{
+    const Vector3& v = line.getDirection();
+    const Vector3& p = line.getPoint();
+    vx[index] = v.x;  vy[index] = v.y;  vz[index] = v.z;
+    px[index] = p.x;  py[index] = p.y;  pz[index] = p.z;
+}
+
+Line LineBatch::get(int index) const
+{
+    return Line(Vector3(vx[index], vy[index], vz[index]),
+                Vector3(px[index], py[index], pz[index]));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the intersection of all lines with a plane, SIMD_WIDTH lines at once.
+// It uses the same formula as Plane::intersect(const Line&), but returns the
+// parameter t of the intersection point (p + tV) instead of the point.
+// t = -(a*x0 + b*y0 + c*z0 + d) / (a*x + b*y + c*z)
+//
+// The status is INTERSECTION_HIT if the line hits the plane within
+// [tMin, tMax], INTERSECTION_NONE if t is out of range, INTERSECTION_PARALLEL
+// or INTERSECTION_COINCIDENT (the line is on the plane) if the line is
+// parallel to the plane (or t overflows, a hit is always finite). The rules
+// of parallel and coincident are same as Plane::getIntersection(const Line&),
+// see Intersection.h. t of a non-hit line is set to 0.
+// Return the number of hits.
+///////////////////////////////////////////////////////////////////////////////
+int LineBatch::intersect(const Plane& plane, std::vector<float>& t,
+                         std::vector<unsigned char>& status, float tMin, float tMax,
+                         ThreadPool* pool) const
+{
+    int count = size();
+    t.resize(count);
+    status.resize(count);
+
+    const Vector3& normal = plane.getNormal();
+    const SimdFloat a = simdSet(normal.x);
+    const SimdFloat b = simdSet(normal.y);
+    const SimdFloat c = simdSet(normal.z);
+    const SimdFloat d = simdSet(plane.getD());
+    const SimdFloat normalSq = simdSet(normal.dot(normal));
+    const SimdFloat absD = simdSet(fabsf(plane.getD()));
+    const SimdFloat epsilon = simdSet(PARALLEL_EPSILON);
+    const SimdFloat singular = simdSet(SINGULAR_EPSILON);
+    const SimdFloat signBit = simdSet(-0.0f);
+    const SimdFloat lower = simdSet(tMin);
+    const SimdFloat upper = simdSet(tMax);
+    const SimdFloat zero = simdZero();
+
+    std::atomic<int> hitCount(0);
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        int localCount = 0;
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat x = simdLoadN(&vx[i], n), y = simdLoadN(&vy[i], n), z = simdLoadN(&vz[i], n);
+            SimdFloat np = simdAdd(simdAdd(simdMul(a, simdLoadN(&px[i], n)),                // a*x0 + b*y0 + c*z0
+                                           simdMul(b, simdLoadN(&py[i], n))),
+                                           simdMul(c, simdLoadN(&pz[i], n)));
+            SimdFloat dot1 = simdAdd(np, d);                                                // a*x0 + b*y0 + c*z0 + d
+            SimdFloat dot2 = simdAdd(simdAdd(simdMul(a, x), simdMul(b, y)), simdMul(c, z)); // a*x + b*y + c*z
+
+            // parallel if dot2^2 <= e * |N|^2 * |V|^2 (see Intersection.h)
+            SimdFloat lengthSq = simdAdd(simdAdd(simdMul(x, x), simdMul(y, y)), simdMul(z, z));
+            SimdFloat parallel = simdIsNearlyZero(simdMul(dot2, dot2), simdMul(normalSq, lengthSq), epsilon);
+
+            // hit if not parallel and tMin <= t <= tMax
+            // (s must be finite, it overflows if dot2 is tiny)
+            SimdFloat s = simdDiv(simdSub(zero, dot1), dot2);
+            parallel = simdOr(parallel, simdAndNot(simdIsFinite(s), simdTrue()));
+            SimdFloat hit = simdAndNot(parallel, simdAnd(simdCmpGe(s, lower), simdCmpLe(s, upper)));
+
+            // on the plane if |N.p + d| <= e * (|N.p| + |d|)
+            SimdFloat limit = simdMul(singular, simdAdd(simdAndNot(signBit, np), absD));
+            SimdFloat onPlane = simdCmpLe(simdAndNot(signBit, dot1), limit);
+
+            simdStoreN(&t[i], simdAnd(hit, s), n);
+            int bits = simdMoveMask(hit);   // padded lanes have V = 0, never hit
+            int parallelBits = simdMoveMask(parallel);
+            int coincidentBits = simdMoveMask(simdAnd(parallel, onPlane));
+            simdStoreMaskN(&status[i], bits, n);    // INTERSECTION_HIT or NONE
+            simdStoreCodeN(&status[i], parallelBits & ~coincidentBits, INTERSECTION_PARALLEL, n);
+            simdStoreCodeN(&status[i], coincidentBits, INTERSECTION_COINCIDENT, n);
+            localCount += simdCountBits(bits);
+        }
+        hitCount += localCount;
+    }, SIMD_WIDTH);
+
+    return hitCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the closest points of i-th line of this and i-th line of rhs, and
+// the squared distances between them (see Line::closestPoints())
+// w = p2 - p1, n = V1 x V2
+// a = (w x V2).n / n.n
+// b = (w x V1).n / n.n
+// For (nearly) parallel pairs, n.n <= e * V1.V1 * V2.V2, a = 0 and b = -w.V2 / V2.V2
+// (or b = 0 and a = w.V1 / V1.V1 if V2 = 0)
+// The gap g = w + b*V2 - a*V1, distanceSq = g.g
+///////////////////////////////////////////////////////////////////////////////
+int LineBatch::closestPoints(const LineBatch& rhs, std::vector<float>& alpha, std::vector<float>& beta,
+                             std::vector<float>& distanceSq, float maxDistance,
+                             ThreadPool* pool) const
+{
+    int count = std::min(size(), rhs.size());
+    alpha.resize(count);
+    beta.resize(count);
+    distanceSq.resize(count);
+
+    const float *vx2 = rhs.getDirectionX(), *vy2 = rhs.getDirectionY(), *vz2 = rhs.getDirectionZ();
+    const float *px2 = rhs.getPointX(), *py2 = rhs.getPointY(), *pz2 = rhs.getPointZ();
+    const SimdFloat maxDistSq = simdSet(maxDistance * maxDistance);
+    const SimdFloat epsilon = simdSet(PARALLEL_EPSILON);
+    const SimdFloat zero = simdZero();
+    const SimdFloat one = simdSet(1.0f);
+
+    std::atomic<int> nearCount(0);
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        int localCount = 0;
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat x1 = simdLoadN(&vx[i], n), y1 = simdLoadN(&vy[i], n), z1 = simdLoadN(&vz[i], n);
+            SimdFloat x2 = simdLoadN(vx2 + i, n), y2 = simdLoadN(vy2 + i, n), z2 = simdLoadN(vz2 + i, n);
+
+            // w = p2 - p1
+            SimdFloat wx = simdSub(simdLoadN(px2 + i, n), simdLoadN(&px[i], n));
+            SimdFloat wy = simdSub(simdLoadN(py2 + i, n), simdLoadN(&py[i], n));
+            SimdFloat wz = simdSub(simdLoadN(pz2 + i, n), simdLoadN(&pz[i], n));
+
+            // n = V1 x V2
+            SimdFloat nx = simdSub(simdMul(y1, z2), simdMul(z1, y2));
+            SimdFloat ny = simdSub(simdMul(z1, x2), simdMul(x1, z2));
+            SimdFloat nz = simdSub(simdMul(x1, y2), simdMul(y1, x2));
+            SimdFloat dot = simdAdd(simdAdd(simdMul(nx, nx), simdMul(ny, ny)), simdMul(nz, nz));
+            SimdFloat dot1 = simdAdd(simdAdd(simdMul(x1, x1), simdMul(y1, y1)), simdMul(z1, z1));
+            SimdFloat dot2 = simdAdd(simdAdd(simdMul(x2, x2), simdMul(y2, y2)), simdMul(z2, z2));
+            SimdFloat skew = simdAndNot(simdIsNearlyZero(dot, simdMul(dot1, dot2), epsilon), simdTrue());
+
+            // (w x V2).n and (w x V1).n
+            SimdFloat numA = simdAdd(simdAdd(simdMul(simdSub(simdMul(wy, z2), simdMul(wz, y2)), nx),
+                                             simdMul(simdSub(simdMul(wz, x2), simdMul(wx, z2)), ny)),
+                                             simdMul(simdSub(simdMul(wx, y2), simdMul(wy, x2)), nz));
+            SimdFloat numB = simdAdd(simdAdd(simdMul(simdSub(simdMul(wy, z1), simdMul(wz, y1)), nx),
+                                             simdMul(simdSub(simdMul(wz, x1), simdMul(wx, z1)), ny)),
+                                             simdMul(simdSub(simdMul(wx, y1), simdMul(wy, x1)), nz));
+            SimdFloat invDot = simdDiv(one, dot);
+
+            // parallel pairs: a = 0, b = -w.V2 / V2.V2
+            // or if V2 = 0:   a = w.V1 / V1.V1 (0 if V1 = 0), b = 0
+            SimdFloat dotW1 = simdAdd(simdAdd(simdMul(wx, x1), simdMul(wy, y1)), simdMul(wz, z1));
+            SimdFloat dotW2 = simdAdd(simdAdd(simdMul(wx, x2), simdMul(wy, y2)), simdMul(wz, z2));
+            SimdFloat line2 = simdCmpNeq(dot2, zero);
+            SimdFloat a0 = simdAndNot(line2, simdAnd(simdCmpNeq(dot1, zero), simdDiv(dotW1, dot1)));
+            SimdFloat b0 = simdAnd(line2, simdDiv(simdSub(zero, dotW2), dot2));
+
+            SimdFloat a = simdSelect(skew, simdMul(numA, invDot), a0);
+            SimdFloat b = simdSelect(skew, simdMul(numB, invDot), b0);
+
+            // g = w + b*V2 - a*V1
+            SimdFloat gx = simdSub(simdAdd(wx, simdMul(b, x2)), simdMul(a, x1));
+            SimdFloat gy = simdSub(simdAdd(wy, simdMul(b, y2)), simdMul(a, y1));
+            SimdFloat gz = simdSub(simdAdd(wz, simdMul(b, z2)), simdMul(a, z1));
+            SimdFloat distSq = simdAdd(simdAdd(simdMul(gx, gx), simdMul(gy, gy)), simdMul(gz, gz));
+
+            simdStoreN(&alpha[i], a, n);
+            simdStoreN(&beta[i], b, n);
+            simdStoreN(&distanceSq[i], distSq, n);
+
+            // padded lanes have w = 0, so they must be excluded from the count
+            int bits = simdMoveMask(simdCmpLe(distSq, maxDistSq));
+            if(n < SIMD_WIDTH)
+                bits &= (1 << n) - 1;
+            localCount += simdCountBits(bits);
+        }
+        nearCount += localCount;
+    }, SIMD_WIDTH);
+
+    return nearCount;
+}
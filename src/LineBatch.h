@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+// LineBatch.h
+// ===========
+// a set of 3D lines stored as structure of arrays (SoA) for batch kernels
+// Line = p + aV, each component of V and p is stored in a separate array
+//
+// NOTE:
+// 1. All arrays are aligned at SIMD_ALIGNMENT bytes.
+// 2. Use get()/set() to convert from/to a single Line object.
+// 3. intersect(plane) finds the parameter t of the intersection point p + tV
+//    of all lines with a plane, SIMD_WIDTH lines at once. The status of each
+//    line (see Intersection.h) is written to the status array, and its
+//    (status & INTERSECTION_HIT) is the hit mask. The rules of parallel and
+//    coincident are same as Plane (see Intersection.h).
+// 4. closestPoints(rhs) is the batch version of Line::closestPoints() for
+//    i-th line of this and i-th line of rhs. The closest points are
+//    p1 + a*V1 and p2 + b*V2, so only the parameters (a, b) and the squared
+//    distances are written.
+// 5. The batch functions run on the threads of pool if it is given.
+//
+// Dependencies: Line, Plane, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef LINE_BATCH_H_DEF
+#define LINE_BATCH_H_DEF
+
+#include <vector>
+#include "Simd.h"
+#include "Line.h"
+#include "Plane.h"
+#include "ThreadPool.h"
+
+class LineBatch
+{
+public:
+    typedef std::vector<float, AlignedAllocator<float> > FloatArray;
+
+    // ctor/dtor
+    LineBatch() {}
+    LineBatch(const Line* lines, int count);
+    ~LineBatch() {}
+
+    // size
+    int size() const                        { return (int)vx.size(); }
+    void resize(int count);
+    void reserve(int count);
+    void clear();
+
+    // getters/setters
+    void add(const Line& line);
+    void add(float vx, float vy, float vz, float px, float py, float pz);
+    void set(int index, const Line& line);
+    Line get(int index) const;
+    const float* getDirectionX() const      { return vx.data(); }
+    const float* getDirectionY() const      { return vy.data(); }
+    const float* getDirectionZ() const      { return vz.data(); }
+    const float* getPointX() const          { return px.data(); }
+    const float* getPointY() const          { return py.data(); }
+    const float* getPointZ() const          { return pz.data(); }
+    float* getDirectionX()                  { return vx.data(); }
+    float* getDirectionY()                  { return vy.data(); }
+    float* getDirectionZ()                  { return vz.data(); }
+    float* getPointX()                      { return px.data(); }
+    float* getPointY()                      { return py.data(); }
+    float* getPointZ()                      { return pz.data(); }
+
+    // for intersection
+    // intersect all lines with a plane, return # of hits
+    int intersect(const Plane& plane, std::vector<float>& t, std::vector<unsigned char>& status,
+                  float tMin=-INFINITY, float tMax=INFINITY, ThreadPool* pool=0) const;
+
+    // for proximity
+    // closest points of i-th line of this and i-th line of rhs,
+    // return # of pairs closer than or equal to maxDistance
+    int closestPoints(const LineBatch& rhs, std::vector<float>& alpha, std::vector<float>& beta,
+                      std::vector<float>& distanceSq, float maxDistance=INFINITY,
+                      ThreadPool* pool=0) const;
+
+protected:
+
+private:
+    FloatArray vx, vy, vz;      // direction vectors
+    FloatArray px, py, pz;      // points on lines
+};
+
+#endif
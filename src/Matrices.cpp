@@ -9,11 +9,11 @@
 //            | 2 5 8 |    |  2  6 10 14 |
 //                         |  3  7 11 15 |
 //
-// Dependencies: Vector2, Vector3, Vector3
+// Dependencies: Vector2, Vector3, Vector3, Simd
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2005-06-24
-// UPDATED: 2017-06-27
+// UPDATED: 2026-10-17
 //
 // Copyright (C) 2005 Song Ho Ahn
 ///////////////////////////////////////////////////////////////////////////////
@@ -22,8 +22,6 @@
 #include <algorithm>
 #include "Matrices.h"
 
-const float DEG2RAD = 3.141593f / 180.0f;
-const float RAD2DEG = 180.0f / 3.141593f;
 const float EPSILON = 0.00001f;
 
 
@@ -756,6 +754,125 @@ Matrix3 Matrix4::getRotationMatrix() const
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// return the matrix to transform normals, the inverse-transpose of upper-left
+// 3x3 part. It is same as the 3x3 part if there is no (non-uniform) scale.
+///////////////////////////////////////////////////////////////////////////////
+Matrix3 Matrix4::getNormalMatrix() const
+{
+    Matrix3 mat = getRotationMatrix();
+    mat.invert().transpose();
+    return mat;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// transform count vertices (x,y,z) of src, and store them to dst
+// The stride is the number of bytes to the next vertex, so it can skip the
+// other attributes of interleaved arrays. src and dst can be same.
+// v' = M * (x,y,z,1), w' is ignored as operator*(const Vector3&)
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4::transformVertices(const float* src, float* dst, int count,
+                                int srcStride, int dstStride) const
+{
+    const char* in = (const char*)src;
+    char* out = (char*)dst;
+
+#if defined(SIMD4)
+    Simd4 c0 = simd4Load(&m[0]);
+    Simd4 c1 = simd4Load(&m[4]);
+    Simd4 c2 = simd4Load(&m[8]);
+    Simd4 c3 = simd4Load(&m[12]);
+    float r[4];
+    for(int i = 0; i < count; ++i, in += srcStride, out += dstStride)
+    {
+        const float* v = (const float*)in;
+        Simd4 p = simd4MulAdd(c0, simd4Set(v[0]), c3);
+        p = simd4MulAdd(c1, simd4Set(v[1]), p);
+        p = simd4MulAdd(c2, simd4Set(v[2]), p);
+        simd4Store(r, p);
+
+        float* o = (float*)out;
+        o[0] = r[0];
+        o[1] = r[1];
+        o[2] = r[2];
+    }
+#else
+    for(int i = 0; i < count; ++i, in += srcStride, out += dstStride)
+    {
+        const float* v = (const float*)in;
+        float x = v[0], y = v[1], z = v[2];
+
+        float* o = (float*)out;
+        o[0] = m[0]*x + m[4]*y + m[8]*z  + m[12];
+        o[1] = m[1]*x + m[5]*y + m[9]*z  + m[13];
+        o[2] = m[2]*x + m[6]*y + m[10]*z + m[14];
+    }
+#endif
+}
+
+void Matrix4::transformVertices(float* vertices, int count, int stride) const
+{
+    transformVertices(vertices, vertices, count, stride, stride);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// transform count normals (x,y,z) of src with the normal matrix (the
+// inverse-transpose of 3x3 part), and store the unit vectors to dst.
+// The normal matrix is computed once per call. src and dst can be same.
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4::transformNormals(const float* src, float* dst, int count,
+                               int srcStride, int dstStride) const
+{
+    const Matrix3 n = getNormalMatrix();
+    const char* in = (const char*)src;
+    char* out = (char*)dst;
+
+#if defined(SIMD4)
+    // pad 3 columns to 4 floats
+    float cols[12] = { n[0], n[1], n[2], 0,  n[3], n[4], n[5], 0,  n[6], n[7], n[8], 0 };
+    Simd4 c0 = simd4Load(&cols[0]);
+    Simd4 c1 = simd4Load(&cols[4]);
+    Simd4 c2 = simd4Load(&cols[8]);
+    float r[4];
+#endif
+
+    for(int i = 0; i < count; ++i, in += srcStride, out += dstStride)
+    {
+        const float* v = (const float*)in;
+#if defined(SIMD4)
+        Simd4 p = simd4Mul(c0, simd4Set(v[0]));
+        p = simd4MulAdd(c1, simd4Set(v[1]), p);
+        p = simd4MulAdd(c2, simd4Set(v[2]), p);
+        simd4Store(r, p);
+        float x = r[0], y = r[1], z = r[2];
+#else
+        float x = n[0]*v[0] + n[3]*v[1] + n[6]*v[2];
+        float y = n[1]*v[0] + n[4]*v[1] + n[7]*v[2];
+        float z = n[2]*v[0] + n[5]*v[1] + n[8]*v[2];
+#endif
+
+        // normalize, keep zero vector as is
+        float lengthSq = x*x + y*y + z*z;
+        float invLength = (lengthSq > 0) ? 1.0f / sqrtf(lengthSq) : 0.0f;
+
+        float* o = (float*)out;
+        o[0] = x * invLength;
+        o[1] = y * invLength;
+        o[2] = z * invLength;
+    }
+}
+
+void Matrix4::transformNormals(float* normals, int count, int stride) const
+{
+    transformNormals(normals, normals, count, stride, stride);
+}
+
+
+
 /*@@
 ///////////////////////////////////////////////////////////////////////////////
 // skew with a given angle on the axis
@@ -9,11 +9,25 @@
 //            | 2 5 8 |    |  2  6 10 14 |
 //                         |  3  7 11 15 |
 //
-// Dependencies: Vector2, Vector3, Vector3
+// Matrix4 * Matrix4 and Matrix4 * Vector3/Vector4 use SSE/AVX (and FMA with
+// -mfma) if the build has them, see Simd.h.
+//
+// The ctors, get(), operator[] const and the element-wise operators are
+// constexpr (C++11 rules). Matrix2/Matrix3 products are constexpr too, but
+// Matrix4 products are not because they use SIMD at run time.
+//
+// Matrix4::transformVertices()/transformNormals() transform the arrays of
+// (x,y,z) with a stride in bytes, so they work on the interleaved vertices
+// of Cylinder (V/N/T, 32 bytes per vertex) as well as the tightly packed ones.
+// e.g. float* v = interleaved; // vertex at offset 0, normal at offset 3 floats
+//      matrix.transformVertices(v, count, 32);
+//      matrix.transformNormals(v + 3, count, 32);
+//
+// Dependencies: Vector2, Vector3, Vector3, Simd
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2005-06-24
-// UPDATED: 2016-07-07
+// UPDATED: 2026-10-17
 //
 // Copyright (C) 2005 Song Ho Ahn
 ///////////////////////////////////////////////////////////////////////////////
@@ -24,6 +38,11 @@
 #include <iostream>
 #include <iomanip>
 #include "Vectors.h"
+#include "Simd.h"
+
+// angle conversion (also used by Quaternion)
+constexpr float DEG2RAD = 3.141593f / 180.0f;
+constexpr float RAD2DEG = 180.0f / 3.141593f;
 
 ///////////////////////////////////////////////////////////////////////////
 // 2x2 matrix
@@ -32,9 +51,9 @@ class Matrix2
 {
 public:
     // constructors
-    Matrix2();  // init with identity
-    Matrix2(const float src[4]);
-    Matrix2(float m0, float m1, float m2, float m3);
+    constexpr Matrix2();  // init with identity
+    constexpr Matrix2(const float src[4]);
+    constexpr Matrix2(float m0, float m1, float m2, float m3);
 
     void        set(const float src[4]);
     void        set(float m0, float m1, float m2, float m3);
@@ -43,7 +62,7 @@ public:
     void        setColumn(int index, const float col[2]);
     void        setColumn(int index, const Vector2& v);
 
-    const float* get() const;
+    constexpr const float* get() const;
     float       getDeterminant() const;
     float       getAngle() const;                       // retrieve angle (degree) from matrix
 
@@ -52,22 +71,22 @@ public:
     Matrix2&    invert();
 
     // operators
-    Matrix2     operator+(const Matrix2& rhs) const;    // add rhs
-    Matrix2     operator-(const Matrix2& rhs) const;    // subtract rhs
+    constexpr Matrix2 operator+(const Matrix2& rhs) const; // add rhs
+    constexpr Matrix2 operator-(const Matrix2& rhs) const; // subtract rhs
     Matrix2&    operator+=(const Matrix2& rhs);         // add rhs and update this object
     Matrix2&    operator-=(const Matrix2& rhs);         // subtract rhs and update this object
-    Vector2     operator*(const Vector2& rhs) const;    // multiplication: v' = M * v
-    Matrix2     operator*(const Matrix2& rhs) const;    // multiplication: M3 = M1 * M2
+    constexpr Vector2 operator*(const Vector2& rhs) const; // multiplication: v' = M * v
+    constexpr Matrix2 operator*(const Matrix2& rhs) const; // multiplication: M3 = M1 * M2
     Matrix2&    operator*=(const Matrix2& rhs);         // multiplication: M1' = M1 * M2
-    bool        operator==(const Matrix2& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Matrix2& rhs) const;   // exact compare, no epsilon
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
+    constexpr bool operator==(const Matrix2& rhs) const; // exact compare, no epsilon
+    constexpr bool operator!=(const Matrix2& rhs) const; // exact compare, no epsilon
+    constexpr float operator[](int index) const;        // subscript operator v[0], v[1]
     float&      operator[](int index);                  // subscript operator v[0], v[1]
 
     // friends functions
-    friend Matrix2 operator-(const Matrix2& m);                     // unary operator (-)
-    friend Matrix2 operator*(float scalar, const Matrix2& m);       // pre-multiplication
-    friend Vector2 operator*(const Vector2& vec, const Matrix2& m); // pre-multiplication
+    friend constexpr Matrix2 operator-(const Matrix2& m);                     // unary operator (-)
+    friend constexpr Matrix2 operator*(float scalar, const Matrix2& m);       // pre-multiplication
+    friend constexpr Vector2 operator*(const Vector2& vec, const Matrix2& m); // pre-multiplication
     friend std::ostream& operator<<(std::ostream& os, const Matrix2& m);
 
     // static functions
@@ -88,9 +107,9 @@ class Matrix3
 {
 public:
     // constructors
-    Matrix3();  // init with identity
-    Matrix3(const float src[9]);
-    Matrix3(float m0, float m1, float m2,           // 1st column
+    constexpr Matrix3();  // init with identity
+    constexpr Matrix3(const float src[9]);
+    constexpr Matrix3(float m0, float m1, float m2,           // 1st column
             float m3, float m4, float m5,           // 2nd column
             float m6, float m7, float m8);          // 3rd column
 
@@ -103,7 +122,7 @@ public:
     void        setColumn(int index, const float col[3]);
     void        setColumn(int index, const Vector3& v);
 
-    const float* get() const;
+    constexpr const float* get() const;
     float       getDeterminant() const;
     Vector3     getAngle() const;                       // return (pitch, yaw, roll)
 
@@ -112,22 +131,22 @@ public:
     Matrix3&    invert();
 
     // operators
-    Matrix3     operator+(const Matrix3& rhs) const;    // add rhs
-    Matrix3     operator-(const Matrix3& rhs) const;    // subtract rhs
+    constexpr Matrix3 operator+(const Matrix3& rhs) const; // add rhs
+    constexpr Matrix3 operator-(const Matrix3& rhs) const; // subtract rhs
     Matrix3&    operator+=(const Matrix3& rhs);         // add rhs and update this object
     Matrix3&    operator-=(const Matrix3& rhs);         // subtract rhs and update this object
-    Vector3     operator*(const Vector3& rhs) const;    // multiplication: v' = M * v
-    Matrix3     operator*(const Matrix3& rhs) const;    // multiplication: M3 = M1 * M2
+    constexpr Vector3 operator*(const Vector3& rhs) const; // multiplication: v' = M * v
+    constexpr Matrix3 operator*(const Matrix3& rhs) const; // multiplication: M3 = M1 * M2
     Matrix3&    operator*=(const Matrix3& rhs);         // multiplication: M1' = M1 * M2
-    bool        operator==(const Matrix3& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Matrix3& rhs) const;   // exact compare, no epsilon
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
+    constexpr bool operator==(const Matrix3& rhs) const; // exact compare, no epsilon
+    constexpr bool operator!=(const Matrix3& rhs) const; // exact compare, no epsilon
+    constexpr float operator[](int index) const;        // subscript operator v[0], v[1]
     float&      operator[](int index);                  // subscript operator v[0], v[1]
 
     // friends functions
-    friend Matrix3 operator-(const Matrix3& m);                     // unary operator (-)
-    friend Matrix3 operator*(float scalar, const Matrix3& m);       // pre-multiplication
-    friend Vector3 operator*(const Vector3& vec, const Matrix3& m); // pre-multiplication
+    friend constexpr Matrix3 operator-(const Matrix3& m);                     // unary operator (-)
+    friend constexpr Matrix3 operator*(float scalar, const Matrix3& m);       // pre-multiplication
+    friend constexpr Vector3 operator*(const Vector3& vec, const Matrix3& m); // pre-multiplication
     friend std::ostream& operator<<(std::ostream& os, const Matrix3& m);
 
 protected:
@@ -146,9 +165,9 @@ class Matrix4
 {
 public:
     // constructors
-    Matrix4();  // init with identity
-    Matrix4(const float src[16]);
-    Matrix4(float m00, float m01, float m02, float m03, // 1st column
+    constexpr Matrix4();  // init with identity
+    constexpr Matrix4(const float src[16]);
+    constexpr Matrix4(float m00, float m01, float m02, float m03, // 1st column
             float m04, float m05, float m06, float m07, // 2nd column
             float m08, float m09, float m10, float m11, // 3rd column
             float m12, float m13, float m14, float m15);// 4th column
@@ -165,10 +184,11 @@ public:
     void        setColumn(int index, const Vector4& v);
     void        setColumn(int index, const Vector3& v);
 
-    const float* get() const;
+    constexpr const float* get() const;
     const float* getTranspose();                        // return transposed matrix
     float       getDeterminant() const;
     Matrix3     getRotationMatrix() const;              // return 3x3 rotation part
+    Matrix3     getNormalMatrix() const;                // return inverse-transpose of 3x3 part
     Vector3     getAngle() const;                       // return (pitch, yaw, roll)
 
     Matrix4&    identity();
@@ -195,25 +215,33 @@ public:
     Matrix4&    lookAt(const Vector3& target, const Vector3& up);
     //@@Matrix4&    skew(float angle, const Vector3& axis); //
 
+    // batch transform of (x,y,z) arrays, stride is # of bytes to the next element
+    void        transformVertices(const float* src, float* dst, int count,
+                                  int srcStride=12, int dstStride=12) const;    // v' = M * v (w = 1)
+    void        transformVertices(float* vertices, int count, int stride=12) const;
+    void        transformNormals(const float* src, float* dst, int count,
+                                 int srcStride=12, int dstStride=12) const;     // n' = normalize(N * n)
+    void        transformNormals(float* normals, int count, int stride=12) const;
+
     // operators
-    Matrix4     operator+(const Matrix4& rhs) const;    // add rhs
-    Matrix4     operator-(const Matrix4& rhs) const;    // subtract rhs
+    constexpr Matrix4 operator+(const Matrix4& rhs) const; // add rhs
+    constexpr Matrix4 operator-(const Matrix4& rhs) const; // subtract rhs
     Matrix4&    operator+=(const Matrix4& rhs);         // add rhs and update this object
     Matrix4&    operator-=(const Matrix4& rhs);         // subtract rhs and update this object
     Vector4     operator*(const Vector4& rhs) const;    // multiplication: v' = M * v
     Vector3     operator*(const Vector3& rhs) const;    // multiplication: v' = M * v
     Matrix4     operator*(const Matrix4& rhs) const;    // multiplication: M3 = M1 * M2
     Matrix4&    operator*=(const Matrix4& rhs);         // multiplication: M1' = M1 * M2
-    bool        operator==(const Matrix4& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Matrix4& rhs) const;   // exact compare, no epsilon
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
+    constexpr bool operator==(const Matrix4& rhs) const; // exact compare, no epsilon
+    constexpr bool operator!=(const Matrix4& rhs) const; // exact compare, no epsilon
+    constexpr float operator[](int index) const;        // subscript operator v[0], v[1]
     float&      operator[](int index);                  // subscript operator v[0], v[1]
 
     // friends functions
-    friend Matrix4 operator-(const Matrix4& m);                     // unary operator (-)
-    friend Matrix4 operator*(float scalar, const Matrix4& m);       // pre-multiplication
-    friend Vector3 operator*(const Vector3& vec, const Matrix4& m); // pre-multiplication
-    friend Vector4 operator*(const Vector4& vec, const Matrix4& m); // pre-multiplication
+    friend constexpr Matrix4 operator-(const Matrix4& m);                     // unary operator (-)
+    friend constexpr Matrix4 operator*(float scalar, const Matrix4& m);       // pre-multiplication
+    friend constexpr Vector3 operator*(const Vector3& vec, const Matrix4& m); // pre-multiplication
+    friend constexpr Vector4 operator*(const Vector4& vec, const Matrix4& m); // pre-multiplication
     friend std::ostream& operator<<(std::ostream& os, const Matrix4& m);
 
 protected:
@@ -233,24 +261,20 @@ private:
 ///////////////////////////////////////////////////////////////////////////
 // inline functions for Matrix2
 ///////////////////////////////////////////////////////////////////////////
-inline Matrix2::Matrix2()
+constexpr Matrix2::Matrix2() : m{1, 0, 0, 1}    // initially identity matrix
 {
-    // initially identity matrix
-    identity();
 }
 
 
 
-inline Matrix2::Matrix2(const float src[4])
+constexpr Matrix2::Matrix2(const float src[4]) : m{src[0], src[1], src[2], src[3]}
 {
-    set(src);
 }
 
 
 
-inline Matrix2::Matrix2(float m0, float m1, float m2, float m3)
+constexpr Matrix2::Matrix2(float m0, float m1, float m2, float m3) : m{m0, m1, m2, m3}
 {
-    set(m0, m1, m2, m3);
 }
 
 
@@ -297,7 +321,7 @@ inline void Matrix2::setColumn(int index, const Vector2& v)
 
 
 
-inline const float* Matrix2::get() const
+constexpr const float* Matrix2::get() const
 {
     return m;
 }
@@ -313,14 +337,14 @@ inline Matrix2& Matrix2::identity()
 
 
 
-inline Matrix2 Matrix2::operator+(const Matrix2& rhs) const
+constexpr Matrix2 Matrix2::operator+(const Matrix2& rhs) const
 {
     return Matrix2(m[0]+rhs[0], m[1]+rhs[1], m[2]+rhs[2], m[3]+rhs[3]);
 }
 
 
 
-inline Matrix2 Matrix2::operator-(const Matrix2& rhs) const
+constexpr Matrix2 Matrix2::operator-(const Matrix2& rhs) const
 {
     return Matrix2(m[0]-rhs[0], m[1]-rhs[1], m[2]-rhs[2], m[3]-rhs[3]);
 }
@@ -343,14 +367,14 @@ inline Matrix2& Matrix2::operator-=(const Matrix2& rhs)
 
 
 
-inline Vector2 Matrix2::operator*(const Vector2& rhs) const
+constexpr Vector2 Matrix2::operator*(const Vector2& rhs) const
 {
     return Vector2(m[0]*rhs.x + m[2]*rhs.y,  m[1]*rhs.x + m[3]*rhs.y);
 }
 
 
 
-inline Matrix2 Matrix2::operator*(const Matrix2& rhs) const
+constexpr Matrix2 Matrix2::operator*(const Matrix2& rhs) const
 {
     return Matrix2(m[0]*rhs[0] + m[2]*rhs[1],  m[1]*rhs[0] + m[3]*rhs[1],
                    m[0]*rhs[2] + m[2]*rhs[3],  m[1]*rhs[2] + m[3]*rhs[3]);
@@ -366,21 +390,21 @@ inline Matrix2& Matrix2::operator*=(const Matrix2& rhs)
 
 
 
-inline bool Matrix2::operator==(const Matrix2& rhs) const
+constexpr bool Matrix2::operator==(const Matrix2& rhs) const
 {
     return (m[0] == rhs[0]) && (m[1] == rhs[1]) && (m[2] == rhs[2]) && (m[3] == rhs[3]);
 }
 
 
 
-inline bool Matrix2::operator!=(const Matrix2& rhs) const
+constexpr bool Matrix2::operator!=(const Matrix2& rhs) const
 {
     return (m[0] != rhs[0]) || (m[1] != rhs[1]) || (m[2] != rhs[2]) || (m[3] != rhs[3]);
 }
 
 
 
-inline float Matrix2::operator[](int index) const
+constexpr float Matrix2::operator[](int index) const
 {
     return m[index];
 }
@@ -394,21 +418,21 @@ inline float& Matrix2::operator[](int index)
 
 
 
-inline Matrix2 operator-(const Matrix2& rhs)
+constexpr Matrix2 operator-(const Matrix2& rhs)
 {
     return Matrix2(-rhs[0], -rhs[1], -rhs[2], -rhs[3]);
 }
 
 
 
-inline Matrix2 operator*(float s, const Matrix2& rhs)
+constexpr Matrix2 operator*(float s, const Matrix2& rhs)
 {
     return Matrix2(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3]);
 }
 
 
 
-inline Vector2 operator*(const Vector2& v, const Matrix2& rhs)
+constexpr Vector2 operator*(const Vector2& v, const Matrix2& rhs)
 {
     return Vector2(v.x*rhs[0] + v.y*rhs[1],  v.x*rhs[2] + v.y*rhs[3]);
 }
@@ -431,26 +455,24 @@ inline std::ostream& operator<<(std::ostream& os, const Matrix2& m)
 ///////////////////////////////////////////////////////////////////////////
 // inline functions for Matrix3
 ///////////////////////////////////////////////////////////////////////////
-inline Matrix3::Matrix3()
+constexpr Matrix3::Matrix3() : m{1, 0, 0,  0, 1, 0,  0, 0, 1}  // initially identity matrix
 {
-    // initially identity matrix
-    identity();
 }
 
 
 
-inline Matrix3::Matrix3(const float src[9])
+constexpr Matrix3::Matrix3(const float src[9]) : m{src[0], src[1], src[2],
+                                                  src[3], src[4], src[5],
+                                                  src[6], src[7], src[8]}
 {
-    set(src);
 }
 
 
 
-inline Matrix3::Matrix3(float m0, float m1, float m2,
-                        float m3, float m4, float m5,
-                        float m6, float m7, float m8)
+constexpr Matrix3::Matrix3(float m0, float m1, float m2,
+                           float m3, float m4, float m5,
+                           float m6, float m7, float m8) : m{m0, m1, m2,  m3, m4, m5,  m6, m7, m8}
 {
-    set(m0, m1, m2,  m3, m4, m5,  m6, m7, m8);
 }
 
 
@@ -503,7 +525,7 @@ inline void Matrix3::setColumn(int index, const Vector3& v)
 
 
 
-inline const float* Matrix3::get() const
+constexpr const float* Matrix3::get() const
 {
     return m;
 }
@@ -519,7 +541,7 @@ inline Matrix3& Matrix3::identity()
 
 
 
-inline Matrix3 Matrix3::operator+(const Matrix3& rhs) const
+constexpr Matrix3 Matrix3::operator+(const Matrix3& rhs) const
 {
     return Matrix3(m[0]+rhs[0], m[1]+rhs[1], m[2]+rhs[2],
                    m[3]+rhs[3], m[4]+rhs[4], m[5]+rhs[5],
@@ -528,7 +550,7 @@ inline Matrix3 Matrix3::operator+(const Matrix3& rhs) const
 
 
 
-inline Matrix3 Matrix3::operator-(const Matrix3& rhs) const
+constexpr Matrix3 Matrix3::operator-(const Matrix3& rhs) const
 {
     return Matrix3(m[0]-rhs[0], m[1]-rhs[1], m[2]-rhs[2],
                    m[3]-rhs[3], m[4]-rhs[4], m[5]-rhs[5],
@@ -557,7 +579,7 @@ inline Matrix3& Matrix3::operator-=(const Matrix3& rhs)
 
 
 
-inline Vector3 Matrix3::operator*(const Vector3& rhs) const
+constexpr Vector3 Matrix3::operator*(const Vector3& rhs) const
 {
     return Vector3(m[0]*rhs.x + m[3]*rhs.y + m[6]*rhs.z,
                    m[1]*rhs.x + m[4]*rhs.y + m[7]*rhs.z,
@@ -566,7 +588,7 @@ inline Vector3 Matrix3::operator*(const Vector3& rhs) const
 
 
 
-inline Matrix3 Matrix3::operator*(const Matrix3& rhs) const
+constexpr Matrix3 Matrix3::operator*(const Matrix3& rhs) const
 {
     return Matrix3(m[0]*rhs[0] + m[3]*rhs[1] + m[6]*rhs[2],  m[1]*rhs[0] + m[4]*rhs[1] + m[7]*rhs[2],  m[2]*rhs[0] + m[5]*rhs[1] + m[8]*rhs[2],
                    m[0]*rhs[3] + m[3]*rhs[4] + m[6]*rhs[5],  m[1]*rhs[3] + m[4]*rhs[4] + m[7]*rhs[5],  m[2]*rhs[3] + m[5]*rhs[4] + m[8]*rhs[5],
@@ -583,7 +605,7 @@ inline Matrix3& Matrix3::operator*=(const Matrix3& rhs)
 
 
 
-inline bool Matrix3::operator==(const Matrix3& rhs) const
+constexpr bool Matrix3::operator==(const Matrix3& rhs) const
 {
     return (m[0] == rhs[0]) && (m[1] == rhs[1]) && (m[2] == rhs[2]) &&
            (m[3] == rhs[3]) && (m[4] == rhs[4]) && (m[5] == rhs[5]) &&
@@ -592,7 +614,7 @@ inline bool Matrix3::operator==(const Matrix3& rhs) const
 
 
 
-inline bool Matrix3::operator!=(const Matrix3& rhs) const
+constexpr bool Matrix3::operator!=(const Matrix3& rhs) const
 {
     return (m[0] != rhs[0]) || (m[1] != rhs[1]) || (m[2] != rhs[2]) ||
            (m[3] != rhs[3]) || (m[4] != rhs[4]) || (m[5] != rhs[5]) ||
@@ -601,7 +623,7 @@ inline bool Matrix3::operator!=(const Matrix3& rhs) const
 
 
 
-inline float Matrix3::operator[](int index) const
+constexpr float Matrix3::operator[](int index) const
 {
     return m[index];
 }
@@ -615,21 +637,21 @@ inline float& Matrix3::operator[](int index)
 
 
 
-inline Matrix3 operator-(const Matrix3& rhs)
+constexpr Matrix3 operator-(const Matrix3& rhs)
 {
     return Matrix3(-rhs[0], -rhs[1], -rhs[2], -rhs[3], -rhs[4], -rhs[5], -rhs[6], -rhs[7], -rhs[8]);
 }
 
 
 
-inline Matrix3 operator*(float s, const Matrix3& rhs)
+constexpr Matrix3 operator*(float s, const Matrix3& rhs)
 {
     return Matrix3(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3], s*rhs[4], s*rhs[5], s*rhs[6], s*rhs[7], s*rhs[8]);
 }
 
 
 
-inline Vector3 operator*(const Vector3& v, const Matrix3& m)
+constexpr Vector3 operator*(const Vector3& v, const Matrix3& m)
 {
     return Vector3(v.x*m[0] + v.y*m[1] + v.z*m[2],  v.x*m[3] + v.y*m[4] + v.z*m[5],  v.x*m[6] + v.y*m[7] + v.z*m[8]);
 }
@@ -653,27 +675,27 @@ inline std::ostream& operator<<(std::ostream& os, const Matrix3& m)
 ///////////////////////////////////////////////////////////////////////////
 // inline functions for Matrix4
 ///////////////////////////////////////////////////////////////////////////
-inline Matrix4::Matrix4()
+constexpr Matrix4::Matrix4() : m{1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1}, tm()  // initially identity matrix
 {
-    // initially identity matrix
-    identity();
 }
 
 
 
-inline Matrix4::Matrix4(const float src[16])
+constexpr Matrix4::Matrix4(const float src[16]) : m{src[0],  src[1],  src[2],  src[3],
+                                                    src[4],  src[5],  src[6],  src[7],
+                                                    src[8],  src[9],  src[10], src[11],
+                                                    src[12], src[13], src[14], src[15]}, tm()
 {
-    set(src);
 }
 
 
 
-inline Matrix4::Matrix4(float m00, float m01, float m02, float m03,
-                        float m04, float m05, float m06, float m07,
-                        float m08, float m09, float m10, float m11,
-                        float m12, float m13, float m14, float m15)
+constexpr Matrix4::Matrix4(float m00, float m01, float m02, float m03,
+                           float m04, float m05, float m06, float m07,
+                           float m08, float m09, float m10, float m11,
+                           float m12, float m13, float m14, float m15)
+    : m{m00, m01, m02, m03,  m04, m05, m06, m07,  m08, m09, m10, m11,  m12, m13, m14, m15}, tm()
 {
-    set(m00, m01, m02, m03,  m04, m05, m06, m07,  m08, m09, m10, m11,  m12, m13, m14, m15);
 }
 
 
@@ -743,7 +765,7 @@ inline void Matrix4::setColumn(int index, const Vector3& v)
 
 
 
-inline const float* Matrix4::get() const
+constexpr const float* Matrix4::get() const
 {
     return m;
 }
@@ -770,7 +792,7 @@ inline Matrix4& Matrix4::identity()
 
 
 
-inline Matrix4 Matrix4::operator+(const Matrix4& rhs) const
+constexpr Matrix4 Matrix4::operator+(const Matrix4& rhs) const
 {
     return Matrix4(m[0]+rhs[0],   m[1]+rhs[1],   m[2]+rhs[2],   m[3]+rhs[3],
                    m[4]+rhs[4],   m[5]+rhs[5],   m[6]+rhs[6],   m[7]+rhs[7],
@@ -780,7 +802,7 @@ inline Matrix4 Matrix4::operator+(const Matrix4& rhs) const
 
 
 
-inline Matrix4 Matrix4::operator-(const Matrix4& rhs) const
+constexpr Matrix4 Matrix4::operator-(const Matrix4& rhs) const
 {
     return Matrix4(m[0]-rhs[0],   m[1]-rhs[1],   m[2]-rhs[2],   m[3]-rhs[3],
                    m[4]-rhs[4],   m[5]-rhs[5],   m[6]-rhs[6],   m[7]-rhs[7],
@@ -812,31 +834,96 @@ inline Matrix4& Matrix4::operator-=(const Matrix4& rhs)
 
 
 
+///////////////////////////////////////////////////////////////////////////
+// 4x4 kernels on column-major float[16], shared by Matrix4 and Matrix4A
+// M * v is the sum of the columns of M scaled by (x, y, z, w), and j-th column
+// of M * N is M * (j-th column of N)
+///////////////////////////////////////////////////////////////////////////
+// r = a * (x, y, z, w)
+inline void multiplyMatrix4(const float* a, float x, float y, float z, float w, float* r)
+{
+#if defined(SIMD4)
+    Simd4 v = simd4Mul(simd4Load(&a[0]), simd4Set(x));
+    v = simd4MulAdd(simd4Load(&a[4]),  simd4Set(y), v);
+    v = simd4MulAdd(simd4Load(&a[8]),  simd4Set(z), v);
+    v = simd4MulAdd(simd4Load(&a[12]), simd4Set(w), v);
+    simd4Store(r, v);
+#else
+    r[0] = a[0]*x + a[4]*y + a[8]*z  + a[12]*w;
+    r[1] = a[1]*x + a[5]*y + a[9]*z  + a[13]*w;
+    r[2] = a[2]*x + a[6]*y + a[10]*z + a[14]*w;
+    r[3] = a[3]*x + a[7]*y + a[11]*z + a[15]*w;
+#endif
+}
+
+// r = a * b, r must not be a or b
+inline void multiplyMatrix4(const float* a, const float* b, float* r)
+{
+#if defined(SIMD4)
+    Simd4 c0 = simd4Load(&a[0]);
+    Simd4 c1 = simd4Load(&a[4]);
+    Simd4 c2 = simd4Load(&a[8]);
+    Simd4 c3 = simd4Load(&a[12]);
+#if defined(SIMD_AVX)
+    // 2 columns at once: both halves hold the columns of a, and permute
+    // broadcasts k-th element of each column of b in its half
+    __m256 cc0 = _mm256_insertf128_ps(_mm256_castps128_ps256(c0), c0, 1);
+    __m256 cc1 = _mm256_insertf128_ps(_mm256_castps128_ps256(c1), c1, 1);
+    __m256 cc2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c2), c2, 1);
+    __m256 cc3 = _mm256_insertf128_ps(_mm256_castps128_ps256(c3), c3, 1);
+    for(int j = 0; j < 16; j += 8)
+    {
+        __m256 col = simdLoad(&b[j]);
+        __m256 v = simdMul(cc0, _mm256_permute_ps(col, 0x00));
+        v = simdMulAdd(cc1, _mm256_permute_ps(col, 0x55), v);
+        v = simdMulAdd(cc2, _mm256_permute_ps(col, 0xAA), v);
+        v = simdMulAdd(cc3, _mm256_permute_ps(col, 0xFF), v);
+        simdStore(&r[j], v);
+    }
+#else
+    for(int j = 0; j < 16; j += 4)
+    {
+        Simd4 v = simd4Mul(c0, simd4Set(b[j]));
+        v = simd4MulAdd(c1, simd4Set(b[j+1]), v);
+        v = simd4MulAdd(c2, simd4Set(b[j+2]), v);
+        v = simd4MulAdd(c3, simd4Set(b[j+3]), v);
+        simd4Store(&r[j], v);
+    }
+#endif
+#else
+    for(int j = 0; j < 16; j += 4)
+    {
+        for(int i = 0; i < 4; ++i)
+            r[j+i] = a[i]*b[j] + a[i+4]*b[j+1] + a[i+8]*b[j+2] + a[i+12]*b[j+3];
+    }
+#endif
+}
+
+
+
 inline Vector4 Matrix4::operator*(const Vector4& rhs) const
 {
-    return Vector4(m[0]*rhs.x + m[4]*rhs.y + m[8]*rhs.z  + m[12]*rhs.w,
-                   m[1]*rhs.x + m[5]*rhs.y + m[9]*rhs.z  + m[13]*rhs.w,
-                   m[2]*rhs.x + m[6]*rhs.y + m[10]*rhs.z + m[14]*rhs.w,
-                   m[3]*rhs.x + m[7]*rhs.y + m[11]*rhs.z + m[15]*rhs.w);
+    float r[4];
+    multiplyMatrix4(m, rhs.x, rhs.y, rhs.z, rhs.w, r);
+    return Vector4(r[0], r[1], r[2], r[3]);
 }
 
 
 
 inline Vector3 Matrix4::operator*(const Vector3& rhs) const
 {
-    return Vector3(m[0]*rhs.x + m[4]*rhs.y + m[8]*rhs.z + m[12],
-                   m[1]*rhs.x + m[5]*rhs.y + m[9]*rhs.z + m[13],
-                   m[2]*rhs.x + m[6]*rhs.y + m[10]*rhs.z+ m[14]);
+    float r[4];
+    multiplyMatrix4(m, rhs.x, rhs.y, rhs.z, 1.0f, r);
+    return Vector3(r[0], r[1], r[2]);
 }
 
 
 
 inline Matrix4 Matrix4::operator*(const Matrix4& n) const
 {
-    return Matrix4(m[0]*n[0]  + m[4]*n[1]  + m[8]*n[2]  + m[12]*n[3],   m[1]*n[0]  + m[5]*n[1]  + m[9]*n[2]  + m[13]*n[3],   m[2]*n[0]  + m[6]*n[1]  + m[10]*n[2]  + m[14]*n[3],   m[3]*n[0]  + m[7]*n[1]  + m[11]*n[2]  + m[15]*n[3],
-                   m[0]*n[4]  + m[4]*n[5]  + m[8]*n[6]  + m[12]*n[7],   m[1]*n[4]  + m[5]*n[5]  + m[9]*n[6]  + m[13]*n[7],   m[2]*n[4]  + m[6]*n[5]  + m[10]*n[6]  + m[14]*n[7],   m[3]*n[4]  + m[7]*n[5]  + m[11]*n[6]  + m[15]*n[7],
-                   m[0]*n[8]  + m[4]*n[9]  + m[8]*n[10] + m[12]*n[11],  m[1]*n[8]  + m[5]*n[9]  + m[9]*n[10] + m[13]*n[11],  m[2]*n[8]  + m[6]*n[9]  + m[10]*n[10] + m[14]*n[11],  m[3]*n[8]  + m[7]*n[9]  + m[11]*n[10] + m[15]*n[11],
-                   m[0]*n[12] + m[4]*n[13] + m[8]*n[14] + m[12]*n[15],  m[1]*n[12] + m[5]*n[13] + m[9]*n[14] + m[13]*n[15],  m[2]*n[12] + m[6]*n[13] + m[10]*n[14] + m[14]*n[15],  m[3]*n[12] + m[7]*n[13] + m[11]*n[14] + m[15]*n[15]);
+    Matrix4 r;
+    multiplyMatrix4(m, n.m, r.m);
+    return r;
 }
 
 
@@ -849,7 +936,7 @@ inline Matrix4& Matrix4::operator*=(const Matrix4& rhs)
 
 
 
-inline bool Matrix4::operator==(const Matrix4& n) const
+constexpr bool Matrix4::operator==(const Matrix4& n) const
 {
     return (m[0] == n[0])  && (m[1] == n[1])  && (m[2] == n[2])  && (m[3] == n[3])  &&
            (m[4] == n[4])  && (m[5] == n[5])  && (m[6] == n[6])  && (m[7] == n[7])  &&
@@ -859,7 +946,7 @@ inline bool Matrix4::operator==(const Matrix4& n) const
 
 
 
-inline bool Matrix4::operator!=(const Matrix4& n) const
+constexpr bool Matrix4::operator!=(const Matrix4& n) const
 {
     return (m[0] != n[0])  || (m[1] != n[1])  || (m[2] != n[2])  || (m[3] != n[3])  ||
            (m[4] != n[4])  || (m[5] != n[5])  || (m[6] != n[6])  || (m[7] != n[7])  ||
@@ -869,7 +956,7 @@ inline bool Matrix4::operator!=(const Matrix4& n) const
 
 
 
-inline float Matrix4::operator[](int index) const
+constexpr float Matrix4::operator[](int index) const
 {
     return m[index];
 }
@@ -883,28 +970,28 @@ inline float& Matrix4::operator[](int index)
 
 
 
-inline Matrix4 operator-(const Matrix4& rhs)
+constexpr Matrix4 operator-(const Matrix4& rhs)
 {
     return Matrix4(-rhs[0], -rhs[1], -rhs[2], -rhs[3], -rhs[4], -rhs[5], -rhs[6], -rhs[7], -rhs[8], -rhs[9], -rhs[10], -rhs[11], -rhs[12], -rhs[13], -rhs[14], -rhs[15]);
 }
 
 
 
-inline Matrix4 operator*(float s, const Matrix4& rhs)
+constexpr Matrix4 operator*(float s, const Matrix4& rhs)
 {
     return Matrix4(s*rhs[0], s*rhs[1], s*rhs[2], s*rhs[3], s*rhs[4], s*rhs[5], s*rhs[6], s*rhs[7], s*rhs[8], s*rhs[9], s*rhs[10], s*rhs[11], s*rhs[12], s*rhs[13], s*rhs[14], s*rhs[15]);
 }
 
 
 
-inline Vector4 operator*(const Vector4& v, const Matrix4& m)
+constexpr Vector4 operator*(const Vector4& v, const Matrix4& m)
 {
     return Vector4(v.x*m[0] + v.y*m[1] + v.z*m[2] + v.w*m[3],  v.x*m[4] + v.y*m[5] + v.z*m[6] + v.w*m[7],  v.x*m[8] + v.y*m[9] + v.z*m[10] + v.w*m[11], v.x*m[12] + v.y*m[13] + v.z*m[14] + v.w*m[15]);
 }
 
 
 
-inline Vector3 operator*(const Vector3& v, const Matrix4& m)
+constexpr Vector3 operator*(const Vector3& v, const Matrix4& m)
 {
     return Vector3(v.x*m[0] + v.y*m[1] + v.z*m[2],  v.x*m[4] + v.y*m[5] + v.z*m[6],  v.x*m[8] + v.y*m[9] + v.z*m[10]);
 }
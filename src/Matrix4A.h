@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+// Matrix4A.h
+// ==========
+// compact 4x4 matrix, 64 bytes and aligned at 64 bytes (a cache line)
+// It is same as Matrix4 (column major order), but has no transpose storage,
+// so an array of Matrix4A is half of Matrix4.
+//
+// NOTE:
+// 1. getTranspose() writes the transposed matrix to a given buffer instead of
+//    returning the pointer of the hidden array.
+// 2. Use AlignedAllocator<Matrix4A, 64> (or Matrix4Array) for std::vector.
+//    The default allocator of C++11 does not keep 64-byte alignment.
+// 3. It converts from/to Matrix4 for the functions not implemented here.
+//
+// Dependencies: Matrix4, Simd
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef MATRIX4A_H_DEF
+#define MATRIX4A_H_DEF
+
+#include <cstring>
+#include "Matrices.h"
+
+class alignas(64) Matrix4A
+{
+public:
+    // ctors
+    Matrix4A()                                  { identity(); }     // init with identity
+    explicit Matrix4A(const float src[16])      { set(src); }
+    Matrix4A(const Matrix4& mat)                { set(mat.get()); }
+
+    void        set(const float src[16])        { std::memcpy(m, src, sizeof(m)); }
+    const float* get() const                    { return m; }
+    void        getTranspose(float dst[16]) const;
+    Matrix4     toMatrix4() const               { return Matrix4(m); }
+
+    Matrix4A&   identity();
+    Matrix4A&   transpose();
+    Matrix4A&   invert();                       // same as Matrix4::invert()
+
+    // operators
+    Vector4     operator*(const Vector4& rhs) const;    // multiplication: v' = M * v
+    Vector3     operator*(const Vector3& rhs) const;    // multiplication: v' = M * v
+    Matrix4A    operator*(const Matrix4A& rhs) const;   // multiplication: M3 = M1 * M2
+    Matrix4A&   operator*=(const Matrix4A& rhs);        // multiplication: M1' = M1 * M2
+    bool        operator==(const Matrix4A& rhs) const   { return std::memcmp(m, rhs.m, sizeof(m)) == 0; }
+    bool        operator!=(const Matrix4A& rhs) const   { return !(*this == rhs); }
+    float       operator[](int index) const             { return m[index]; }
+    float&      operator[](int index)                   { return m[index]; }
+
+private:
+    float m[16];
+};
+
+static_assert(sizeof(Matrix4A) == 64, "Matrix4A must be 64 bytes");
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inline functions for Matrix4A
+///////////////////////////////////////////////////////////////////////////////
+inline void Matrix4A::getTranspose(float dst[16]) const
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        dst[i*4]   = m[i];
+        dst[i*4+1] = m[i+4];
+        dst[i*4+2] = m[i+8];
+        dst[i*4+3] = m[i+12];
+    }
+}
+
+
+
+inline Matrix4A& Matrix4A::identity()
+{
+    m[0] = m[5] = m[10] = m[15] = 1.0f;
+    m[1] = m[2] = m[3] = m[4] = m[6] = m[7] = m[8] = m[9] = m[11] = m[12] = m[13] = m[14] = 0.0f;
+    return *this;
+}
+
+
+
+inline Matrix4A& Matrix4A::transpose()
+{
+    float tmp[16];
+    getTranspose(tmp);
+    set(tmp);
+    return *this;
+}
+
+
+
+inline Matrix4A& Matrix4A::invert()
+{
+    Matrix4 mat(m);
+    mat.invert();
+    set(mat.get());
+    return *this;
+}
+
+
+
+inline Vector4 Matrix4A::operator*(const Vector4& rhs) const
+{
+    float r[4];
+    multiplyMatrix4(m, rhs.x, rhs.y, rhs.z, rhs.w, r);
+    return Vector4(r[0], r[1], r[2], r[3]);
+}
+
+
+
+inline Vector3 Matrix4A::operator*(const Vector3& rhs) const
+{
+    float r[4];
+    multiplyMatrix4(m, rhs.x, rhs.y, rhs.z, 1.0f, r);
+    return Vector3(r[0], r[1], r[2]);
+}
+
+
+
+inline Matrix4A Matrix4A::operator*(const Matrix4A& rhs) const
+{
+    Matrix4A r;
+    multiplyMatrix4(m, rhs.m, r.m);
+    return r;
+}
+
+
+
+inline Matrix4A& Matrix4A::operator*=(const Matrix4A& rhs)
+{
+    *this = *this * rhs;
+    return *this;
+}
+
+#endif
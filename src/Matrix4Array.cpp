@@ -0,0 +1,294 @@
+///////////////////////////////////////////////////////////////////////////////
+// Matrix4Array.cpp
+// ================
+// a large set of 4x4 matrices (instance transforms) with bulk operations
+// The layout is an array of matrices (AOS) or 16 arrays of elements (SOA).
+//
+// Dependencies: Matrix4A, MatrixBatch, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include "Matrix4Array.h"
+#include "MatrixBatch.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor with count identity matrices
+///////////////////////////////////////////////////////////////////////////////
+Matrix4Array::Matrix4Array(int count, Layout layout) : layout(layout), count(0),
+                                                       stride(layout == AOS ? 16 : 0)
+{
+    resize(count);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// resize the array, keep the first matrices and add identity matrices
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::resize(int count)
+{
+    count = std::max(count, 0);
+    int oldCount = this->count;
+
+    if(layout == AOS)
+    {
+        data.resize(count * 16);
+    }
+    else
+    {
+        // element arrays move if the stride changes
+        int newStride = (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+        if(newStride != stride)
+        {
+            FloatArray newData(newStride * 16);
+            int copyCount = std::min(oldCount, count);
+            for(int k = 0; k < 16 && copyCount > 0; ++k)
+                std::memcpy(&newData[k * newStride], &data[k * stride], copyCount * sizeof(float));
+            data.swap(newData);
+            stride = newStride;
+        }
+    }
+
+    this->count = count;
+    if(count > oldCount)
+        setIdentity(oldCount, count);
+}
+
+void Matrix4Array::clear()
+{
+    data.clear();
+    count = 0;
+    stride = (layout == AOS) ? 16 : 0;
+}
+
+void Matrix4Array::setIdentity(int first, int last)
+{
+    for(int i = first; i < last; ++i)
+    {
+        for(int k = 0; k < 16; ++k)
+            data[getIndex(i, k)] = (k % 5 == 0) ? 1.0f : 0.0f;     // 0, 5, 10, 15
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// convert the data to the other layout
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::setLayout(Layout layout)
+{
+    if(this->layout == layout)
+        return;
+
+    Matrix4Array tmp(layout);
+    tmp.resize(count);
+    for(int i = 0; i < count; ++i)
+    {
+        for(int k = 0; k < 16; ++k)
+            tmp.data[tmp.getIndex(i, k)] = data[getIndex(i, k)];
+    }
+
+    this->layout = layout;
+    stride = tmp.stride;
+    data.swap(tmp.data);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// setters/getters
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::set(int index, const Matrix4A& m)
+{
+    for(int k = 0; k < 16; ++k)
+        data[getIndex(index, k)] = m[k];
+}
+
+Matrix4A Matrix4Array::get(int index) const
+{
+    Matrix4A m;
+    for(int k = 0; k < 16; ++k)
+        m[k] = data[getIndex(index, k)];
+    return m;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// multiply all matrices by a matrix
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::preMultiply(const Matrix4A& lhs, ThreadPool* pool)
+{
+    if(layout == AOS)
+        multiplyAos(count, lhs.get(), 0, data.data(), 16, data.data(), pool);
+    else
+        multiplySoa(count, lhs.get(), 0, data.data(), stride, data.data(), stride, pool);
+}
+
+void Matrix4Array::postMultiply(const Matrix4A& rhs, ThreadPool* pool)
+{
+    if(layout == AOS)
+        multiplyAos(count, data.data(), 16, rhs.get(), 0, data.data(), pool);
+    else
+        multiplySoa(count, data.data(), stride, rhs.get(), 0, data.data(), stride, pool);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// out[i] = this[i] * rhs[i] for the first min(size(), rhs.size()) matrices
+// out has the layout of this, and it can be this or rhs.
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::multiply(const Matrix4Array& rhs, Matrix4Array& out, ThreadPool* pool) const
+{
+    // convert rhs to the same layout
+    Matrix4Array converted;
+    const Matrix4Array* other = &rhs;
+    if(rhs.layout != layout)
+    {
+        converted = rhs;
+        converted.setLayout(layout);
+        other = &converted;
+    }
+
+    int n = std::min(count, rhs.count);
+    Matrix4Array result(layout);
+    result.resize(n);
+    if(layout == AOS)
+        multiplyAos(n, data.data(), 16, other->data.data(), 16, result.data.data(), pool);
+    else
+        multiplySoa(n, data.data(), stride, other->data.data(), other->stride,
+                    result.data.data(), result.stride, pool);
+
+    out.layout = result.layout;
+    out.count = result.count;
+    out.stride = result.stride;
+    out.data.swap(result.data);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// invert all matrices, SIMD_WIDTH matrices at once (see MatrixBatch.h)
+// A singular matrix (|det| <= 0.00001) is left unchanged, and flagged in
+// singular with 1.
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::invert(std::vector<float>& determinants, std::vector<unsigned char>& singular,
+                          ThreadPool* pool)
+{
+    determinants.resize(count);
+    singular.resize(count);
+    invert(determinants.data(), singular.data(), pool);
+}
+
+void Matrix4Array::invert(ThreadPool* pool)
+{
+    invert(0, 0, pool);
+}
+
+void Matrix4Array::invert(float* determinants, unsigned char* singular, ThreadPool* pool)
+{
+    if(layout == AOS)
+        invertMatrix4Aos(data.data(), count, determinants, singular, pool);
+    else
+        invertMatrix4Soa(data.data(), stride, count, determinants, singular, pool);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy all matrices to dst, 16 floats per matrix in column major order
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::copyTo(float* dst, ThreadPool* pool) const
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        if(layout == AOS)
+        {
+            std::memcpy(dst + first * 16, &data[first * 16], (last - first) * 16 * sizeof(float));
+            return;
+        }
+
+        for(int i = first; i < last; ++i)
+        {
+            for(int k = 0; k < 16; ++k)
+                dst[i * 16 + k] = data[k * stride + i];
+        }
+    }, SIMD_WIDTH);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dst[i] = lhs[i] * rhs[i] of AOS arrays, a matrix at a time.
+// The step is # of floats to the next matrix, 0 for the same matrix.
+// dst can be lhs or rhs.
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::multiplyAos(int count, const float* lhs, int lhsStep, const float* rhs, int rhsStep,
+                               float* dst, ThreadPool* pool)
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        float m[16];
+        for(int i = first; i < last; ++i)
+        {
+            multiplyMatrix4(lhs + i * lhsStep, rhs + i * rhsStep, m);
+            std::memcpy(dst + i * 16, m, sizeof(m));
+        }
+    }, SIMD_WIDTH);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dst[i] = lhs[i] * rhs[i] of SOA arrays, SIMD_WIDTH matrices at once.
+// The stride is # of floats to the next element array, 0 for the same matrix
+// (16 floats in column major order). dst can be lhs or rhs.
+// Element (r, c) of the product: sum of lhs(r, k) * rhs(k, c)
+///////////////////////////////////////////////////////////////////////////////
+void Matrix4Array::multiplySoa(int count, const float* lhs, int lhsStride, const float* rhs, int rhsStride,
+                               float* dst, int dstStride, ThreadPool* pool)
+{
+    if(count <= 0)
+        return;
+
+    // broadcast the elements of the same matrix
+    SimdFloat lhsElements[16], rhsElements[16];
+    for(int k = 0; k < 16; ++k)
+    {
+        lhsElements[k] = (lhsStride == 0) ? simdSet(lhs[k]) : simdZero();
+        rhsElements[k] = (rhsStride == 0) ? simdSet(rhs[k]) : simdZero();
+    }
+
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        SimdFloat a[16], b[16];
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            // the stride is a multiple of SIMD_WIDTH, so the last vector is in the padding
+            for(int k = 0; k < 16; ++k)
+            {
+                a[k] = (lhsStride == 0) ? lhsElements[k] : simdLoad(lhs + k * lhsStride + i);
+                b[k] = (rhsStride == 0) ? rhsElements[k] : simdLoad(rhs + k * rhsStride + i);
+            }
+
+            for(int c = 0; c < 4; ++c)
+            {
+                for(int r = 0; r < 4; ++r)
+                {
+                    SimdFloat v = simdMul(a[r], b[c*4]);
+                    v = simdMulAdd(a[r+4], b[c*4+1], v);
+                    v = simdMulAdd(a[r+8], b[c*4+2], v);
+                    v = simdMulAdd(a[r+12], b[c*4+3], v);
+                    simdStore(dst + (c*4+r) * dstStride + i, v);
+                }
+            }
+        }
+    }, SIMD_WIDTH);
+}
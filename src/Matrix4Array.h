@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+// Matrix4Array.h
+// ==============
+// a large set of 4x4 matrices (instance transforms) with bulk operations
+// The layout is selectable:
+//   AOS: array of matrices, matrix i is at getData() + 16*i (column major),
+//        same as an array of Matrix4A, ready to upload as is.
+//   SOA: 16 arrays of elements, element k of matrix i is at
+//        getData()[k*getStride() + i]. The bulk operations process
+//        SIMD_WIDTH matrices at once.
+//
+// NOTE:
+// 1. The data is aligned at 64 bytes. The stride of SOA is a multiple of
+//    SIMD_WIDTH, and the padded lanes are not part of the matrices.
+// 2. New matrices of resize() are identity.
+// 3. The bulk functions run on the threads of pool if it is given.
+// 4. invert() leaves a singular matrix unchanged instead of identity of
+//    Matrix4::invert(). The overload with arrays reports them.
+//
+// Dependencies: Matrix4A, MatrixBatch, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef MATRIX4_ARRAY_H_DEF
+#define MATRIX4_ARRAY_H_DEF
+
+#include <vector>
+#include "Simd.h"
+#include "Matrix4A.h"
+#include "ThreadPool.h"
+
+class Matrix4Array
+{
+public:
+    enum Layout
+    {
+        AOS,                                // array of matrices
+        SOA                                 // array of elements
+    };
+    typedef std::vector<float, AlignedAllocator<float, 64> > FloatArray;
+
+    // ctor/dtor
+    Matrix4Array(Layout layout=AOS) : layout(layout), count(0), stride(layout == AOS ? 16 : 0) {}
+    Matrix4Array(int count, Layout layout=AOS);     // count identity matrices
+    ~Matrix4Array() {}
+
+    // size
+    int size() const                        { return count; }
+    void resize(int count);
+    void clear();
+
+    // getters/setters
+    Layout getLayout() const                { return layout; }
+    void setLayout(Layout layout);          // convert the data to the layout
+    void set(int index, const Matrix4A& m);
+    Matrix4A get(int index) const;
+    int getStride() const                   { return stride; }  // # of floats per matrix (AOS) or element (SOA)
+    const float* getData() const            { return data.data(); }
+    float* getData()                        { return data.data(); }
+
+    // bulk operations
+    void preMultiply(const Matrix4A& lhs, ThreadPool* pool=0);     // M[i] = lhs * M[i]
+    void postMultiply(const Matrix4A& rhs, ThreadPool* pool=0);    // M[i] = M[i] * rhs
+    void multiply(const Matrix4Array& rhs, Matrix4Array& out,      // out[i] = M[i] * rhs[i]
+                  ThreadPool* pool=0) const;
+    void invert(ThreadPool* pool=0);                               // M[i] = inverse of M[i]
+    void invert(std::vector<float>& determinants,                  // same, with det(M[i]) and
+                std::vector<unsigned char>& singular,              // singular flag (1 = unchanged)
+                ThreadPool* pool=0);
+
+    // copy all matrices to dst as column major float[16] each, e.g. to a
+    // mapped buffer object or glUniformMatrix4fv()
+    void copyTo(float* dst, ThreadPool* pool=0) const;
+
+protected:
+
+private:
+    int getIndex(int index, int element) const  // position of element of matrix
+    {
+        return (layout == AOS) ? index * 16 + element : element * stride + index;
+    }
+    void setIdentity(int first, int last);
+    void invert(float* determinants, unsigned char* singular, ThreadPool* pool);
+    static void multiplyAos(int count, const float* lhs, int lhsStep, const float* rhs, int rhsStep,
+                            float* dst, ThreadPool* pool);
+    static void multiplySoa(int count, const float* lhs, int lhsStride, const float* rhs, int rhsStride,
+                            float* dst, int dstStride, ThreadPool* pool);
+
+    Layout layout;
+    int count;                              // # of matrices
+    int stride;                             // 16 (AOS), or count rounded up to SIMD_WIDTH (SOA)
+    FloatArray data;
+};
+
+#endif
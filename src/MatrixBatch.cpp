@@ -0,0 +1,306 @@
+///////////////////////////////////////////////////////////////////////////////
+// MatrixBatch.cpp
+// ===============
+// batch inverse of Matrix3/Matrix4 arrays, SIMD_WIDTH matrices at once
+//
+// Dependencies: Matrix3, Matrix4, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include "MatrixBatch.h"
+
+const float EPSILON = 0.00001f;         // same as Matrix3::invert()
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// a*b - c*d of each lane
+///////////////////////////////////////////////////////////////////////////////
+static inline SimdFloat det2(SimdFloat a, SimdFloat b, SimdFloat c, SimdFloat d)
+{
+    return simdMulSub(a, b, simdMul(c, d));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inverse of SIMD_WIDTH 3x3 matrices, a[k] is element k of all matrices
+// same as Matrix3::invert(): M^-1 = adj(M) / det(M)
+// It writes the inverse to b and returns the determinants.
+///////////////////////////////////////////////////////////////////////////////
+static SimdFloat invertSoa(const SimdFloat (&a)[9], SimdFloat (&b)[9])
+{
+    SimdFloat t[9];
+    t[0] = det2(a[4], a[8], a[5], a[7]);
+    t[1] = det2(a[7], a[2], a[8], a[1]);
+    t[2] = det2(a[1], a[5], a[2], a[4]);
+    t[3] = det2(a[5], a[6], a[3], a[8]);
+    t[4] = det2(a[0], a[8], a[2], a[6]);
+    t[5] = det2(a[2], a[3], a[0], a[5]);
+    t[6] = det2(a[3], a[7], a[4], a[6]);
+    t[7] = det2(a[6], a[1], a[7], a[0]);
+    t[8] = det2(a[0], a[4], a[1], a[3]);
+
+    SimdFloat det = simdMulAdd(a[0], t[0], simdMulAdd(a[1], t[3], simdMul(a[2], t[6])));
+    SimdFloat invDet = simdDiv(simdSet(1.0f), det);
+    for(int k = 0; k < 9; ++k)
+        b[k] = simdMul(t[k], invDet);
+    return det;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inverse of SIMD_WIDTH 4x4 matrices, a[k] is element k of all matrices
+// It expands the determinant with 2x2 minors of the first 2 and the last 2
+// columns (s and c) instead of 16 3x3 cofactors of Matrix4::invertGeneral().
+// It writes the inverse to b and returns the determinants.
+///////////////////////////////////////////////////////////////////////////////
+static SimdFloat invertSoa(const SimdFloat (&a)[16], SimdFloat (&b)[16])
+{
+    // 2x2 minors of the first 2 columns
+    SimdFloat s0 = det2(a[0], a[5], a[4], a[1]);
+    SimdFloat s1 = det2(a[0], a[6], a[4], a[2]);
+    SimdFloat s2 = det2(a[0], a[7], a[4], a[3]);
+    SimdFloat s3 = det2(a[1], a[6], a[5], a[2]);
+    SimdFloat s4 = det2(a[1], a[7], a[5], a[3]);
+    SimdFloat s5 = det2(a[2], a[7], a[6], a[3]);
+
+    // 2x2 minors of the last 2 columns
+    SimdFloat c5 = det2(a[10], a[15], a[14], a[11]);
+    SimdFloat c4 = det2(a[9],  a[15], a[13], a[11]);
+    SimdFloat c3 = det2(a[9],  a[14], a[13], a[10]);
+    SimdFloat c2 = det2(a[8],  a[15], a[12], a[11]);
+    SimdFloat c1 = det2(a[8],  a[14], a[12], a[10]);
+    SimdFloat c0 = det2(a[8],  a[13], a[12], a[9]);
+
+    // det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0
+    SimdFloat det = simdMul(s0, c5);
+    det = simdSub(det, simdMul(s1, c4));
+    det = simdMulAdd(s2, c3, det);
+    det = simdMulAdd(s3, c2, det);
+    det = simdSub(det, simdMul(s4, c1));
+    det = simdMulAdd(s5, c0, det);
+    SimdFloat invDet = simdDiv(simdSet(1.0f), det);
+
+    // adj(M) / det(M)
+    b[0]  = simdMul(simdAdd(det2(a[5],  c5, a[6],  c4), simdMul(a[7],  c3)), invDet);
+    b[1]  = simdMul(simdSub(det2(a[2],  c4, a[1],  c5), simdMul(a[3],  c3)), invDet);
+    b[2]  = simdMul(simdAdd(det2(a[13], s5, a[14], s4), simdMul(a[15], s3)), invDet);
+    b[3]  = simdMul(simdSub(det2(a[10], s4, a[9],  s5), simdMul(a[11], s3)), invDet);
+
+    b[4]  = simdMul(simdSub(det2(a[6],  c2, a[4],  c5), simdMul(a[7],  c1)), invDet);
+    b[5]  = simdMul(simdAdd(det2(a[0],  c5, a[2],  c2), simdMul(a[3],  c1)), invDet);
+    b[6]  = simdMul(simdSub(det2(a[14], s2, a[12], s5), simdMul(a[15], s1)), invDet);
+    b[7]  = simdMul(simdAdd(det2(a[8],  s5, a[10], s2), simdMul(a[11], s1)), invDet);
+
+    b[8]  = simdMul(simdAdd(det2(a[4],  c4, a[5],  c2), simdMul(a[7],  c0)), invDet);
+    b[9]  = simdMul(simdSub(det2(a[1],  c2, a[0],  c4), simdMul(a[3],  c0)), invDet);
+    b[10] = simdMul(simdAdd(det2(a[12], s4, a[13], s2), simdMul(a[15], s0)), invDet);
+    b[11] = simdMul(simdSub(det2(a[9],  s2, a[8],  s4), simdMul(a[11], s0)), invDet);
+
+    b[12] = simdMul(simdSub(det2(a[5],  c1, a[4],  c3), simdMul(a[6],  c0)), invDet);
+    b[13] = simdMul(simdAdd(det2(a[0],  c3, a[1],  c1), simdMul(a[2],  c0)), invDet);
+    b[14] = simdMul(simdSub(det2(a[13], s1, a[12], s3), simdMul(a[14], s0)), invDet);
+    b[15] = simdMul(simdAdd(det2(a[8],  s3, a[9],  s1), simdMul(a[10], s0)), invDet);
+
+    return det;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// replace a with the inverse b of the regular lanes, keep the singular ones,
+// and store the determinants and singular flags of count lanes
+///////////////////////////////////////////////////////////////////////////////
+template<int E>
+static void selectInverse(SimdFloat (&a)[E], const SimdFloat (&b)[E], SimdFloat det, int count,
+                          float* determinants, unsigned char* singular)
+{
+    // NaN determinant is singular as well
+    SimdFloat regular = simdCmpGt(simdAndNot(simdSet(-0.0f), det), simdSet(EPSILON));
+    for(int k = 0; k < E; ++k)
+        a[k] = simdSelect(regular, b[k], a[k]);
+
+    if(determinants)
+        simdStoreN(determinants, det, count);
+    if(singular)
+        simdStoreMaskN(singular, ~simdMoveMask(regular), count);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// transpose 4 of 4x4 matrices (i+j ... i+j+3) to/from the lanes j..j+3 of
+// the SoA buffer with SSE shuffles. Column c of the 4 matrices becomes the
+// elements 4c..4c+3. Return false if SIMD4 is not available.
+///////////////////////////////////////////////////////////////////////////////
+template<typename Access>
+static bool gather4x4(Access matrix, int i, int j, float* buffer)
+{
+#if defined(SIMD4)
+    for(int c = 0; c < 16; c += 4)
+    {
+        Simd4 r0 = simd4Load(matrix(i + j) + c);
+        Simd4 r1 = simd4Load(matrix(i + j + 1) + c);
+        Simd4 r2 = simd4Load(matrix(i + j + 2) + c);
+        Simd4 r3 = simd4Load(matrix(i + j + 3) + c);
+        simd4Transpose(r0, r1, r2, r3);
+        simd4Store(buffer + c * SIMD_WIDTH + j, r0);
+        simd4Store(buffer + (c + 1) * SIMD_WIDTH + j, r1);
+        simd4Store(buffer + (c + 2) * SIMD_WIDTH + j, r2);
+        simd4Store(buffer + (c + 3) * SIMD_WIDTH + j, r3);
+    }
+    return true;
+#else
+    (void)matrix; (void)i; (void)j; (void)buffer;
+    return false;
+#endif
+}
+
+template<typename Access>
+static bool scatter4x4(Access matrix, int i, int j, const float* buffer)
+{
+#if defined(SIMD4)
+    for(int c = 0; c < 16; c += 4)
+    {
+        Simd4 r0 = simd4Load(buffer + c * SIMD_WIDTH + j);
+        Simd4 r1 = simd4Load(buffer + (c + 1) * SIMD_WIDTH + j);
+        Simd4 r2 = simd4Load(buffer + (c + 2) * SIMD_WIDTH + j);
+        Simd4 r3 = simd4Load(buffer + (c + 3) * SIMD_WIDTH + j);
+        simd4Transpose(r0, r1, r2, r3);
+        simd4Store(matrix(i + j) + c, r0);
+        simd4Store(matrix(i + j + 1) + c, r1);
+        simd4Store(matrix(i + j + 2) + c, r2);
+        simd4Store(matrix(i + j + 3) + c, r3);
+    }
+    return true;
+#else
+    (void)matrix; (void)i; (void)j; (void)buffer;
+    return false;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// invert count matrices of NxN, matrix(i) returns the pointer to the
+// elements of i-th matrix. SIMD_WIDTH matrices are transposed to a buffer
+// (one vector per element), inverted, and transposed back.
+///////////////////////////////////////////////////////////////////////////////
+template<int N, typename Access>
+static void invertGathered(int count, Access matrix, float* determinants, unsigned char* singular,
+                           ThreadPool* pool)
+{
+    const int E = N * N;
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        float buffer[E * SIMD_WIDTH];
+        SimdFloat a[E], b[E];
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            // the unused lanes of the last vector are 0 (singular)
+            int n = std::min(SIMD_WIDTH, last - i);
+            if(n < SIMD_WIDTH)
+                std::memset(buffer, 0, sizeof(buffer));
+
+            for(int j = 0; j < n; ++j)
+            {
+                if(N == 4 && n == SIMD_WIDTH && gather4x4(matrix, i, j, buffer))
+                {
+                    j += 3;
+                    continue;
+                }
+                const float* m = matrix(i + j);
+                for(int k = 0; k < E; ++k)
+                    buffer[k * SIMD_WIDTH + j] = m[k];
+            }
+            for(int k = 0; k < E; ++k)
+                a[k] = simdLoad(buffer + k * SIMD_WIDTH);
+
+            SimdFloat det = invertSoa(a, b);
+            selectInverse(a, b, det, n, determinants ? determinants + i : 0, singular ? singular + i : 0);
+
+            for(int k = 0; k < E; ++k)
+                simdStore(buffer + k * SIMD_WIDTH, a[k]);
+            for(int j = 0; j < n; ++j)
+            {
+                if(N == 4 && n == SIMD_WIDTH && scatter4x4(matrix, i, j, buffer))
+                {
+                    j += 3;
+                    continue;
+                }
+                float* m = matrix(i + j);
+                for(int k = 0; k < E; ++k)
+                    m[k] = buffer[k * SIMD_WIDTH + j];
+            }
+        }
+    }, SIMD_WIDTH);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// invert arrays of Matrix3/Matrix4
+///////////////////////////////////////////////////////////////////////////////
+void invertMatrices(Matrix3* matrices, int count, std::vector<float>& determinants,
+                    std::vector<unsigned char>& singular, ThreadPool* pool)
+{
+    count = std::max(count, 0);
+    determinants.resize(count);
+    singular.resize(count);
+    invertGathered<3>(count, [matrices](int i) { return &matrices[i][0]; },
+                      determinants.data(), singular.data(), pool);
+}
+
+void invertMatrices(Matrix4* matrices, int count, std::vector<float>& determinants,
+                    std::vector<unsigned char>& singular, ThreadPool* pool)
+{
+    count = std::max(count, 0);
+    determinants.resize(count);
+    singular.resize(count);
+    invertGathered<4>(count, [matrices](int i) { return &matrices[i][0]; },
+                      determinants.data(), singular.data(), pool);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// invert count 4x4 matrices of 16 floats each
+///////////////////////////////////////////////////////////////////////////////
+void invertMatrix4Aos(float* data, int count, float* determinants, unsigned char* singular,
+                      ThreadPool* pool)
+{
+    invertGathered<4>(count, [data](int i) { return data + i * 16; }, determinants, singular, pool);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// invert count 4x4 matrices of SoA, element k of matrix i is at
+// data[k*stride + i]. It loads the elements directly, no transpose.
+///////////////////////////////////////////////////////////////////////////////
+void invertMatrix4Soa(float* data, int stride, int count, float* determinants, unsigned char* singular,
+                      ThreadPool* pool)
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        SimdFloat a[16], b[16];
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = std::min(SIMD_WIDTH, last - i);
+            for(int k = 0; k < 16; ++k)
+                a[k] = simdLoadN(data + k * stride + i, n);
+
+            SimdFloat det = invertSoa(a, b);
+            selectInverse(a, b, det, n, determinants ? determinants + i : 0, singular ? singular + i : 0);
+
+            for(int k = 0; k < 16; ++k)
+                simdStoreN(data + k * stride + i, a[k], n);
+        }
+    }, SIMD_WIDTH);
+}
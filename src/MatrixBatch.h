@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////////////////
+// MatrixBatch.h
+// =============
+// batch inverse of Matrix3/Matrix4 arrays, SIMD_WIDTH matrices at once
+// The matrices are transposed to structure of arrays (one SIMD vector per
+// element), and inverted with the cofactors (adjugate / determinant).
+//
+// NOTE:
+// 1. It writes the determinant and the singular flag (1 byte per matrix) of
+//    each matrix. A matrix is singular if |det| <= 0.00001 (same as
+//    Matrix3::invert()), and the singular matrix is left unchanged instead
+//    of being replaced by identity.
+// 2. The arrays of Matrix3/Matrix4 are gathered to SoA and scattered back.
+//    invertMatrix4Soa() works on the SoA data as is, e.g. Matrix4Array:
+//    element k of matrix i is at data[k*stride + i].
+// 3. determinants and singular of the raw functions can be NULL.
+// 4. The batch functions run on the threads of pool if it is given.
+//
+// Dependencies: Matrix3, Matrix4, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef MATRIX_BATCH_H_DEF
+#define MATRIX_BATCH_H_DEF
+
+#include <vector>
+#include "Matrices.h"
+#include "Simd.h"
+#include "ThreadPool.h"
+
+// arrays of matrices, determinants and singular are resized to count
+void invertMatrices(Matrix3* matrices, int count, std::vector<float>& determinants,
+                    std::vector<unsigned char>& singular, ThreadPool* pool=0);
+void invertMatrices(Matrix4* matrices, int count, std::vector<float>& determinants,
+                    std::vector<unsigned char>& singular, ThreadPool* pool=0);
+
+// raw float arrays of 4x4 matrices (column major)
+void invertMatrix4Aos(float* data, int count, float* determinants,          // 16 floats per matrix
+                      unsigned char* singular, ThreadPool* pool=0);
+void invertMatrix4Soa(float* data, int stride, int count, float* determinants, // element k at data[k*stride]
+                      unsigned char* singular, ThreadPool* pool=0);
+
+#endif
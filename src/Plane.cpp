@@ -8,27 +8,34 @@
 // 1. The default plane is z = 0 (a plane on XY axis)
 // 2. The distance is the length from the origin to the plane
 //
-// Dependencies: Vector3, Line
+// Dependencies: Vector3, Line, Predicates, Intersection
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-01-19
-// UPDATED: 2017-06-29
+// UPDATED: 2026-10-17
 ///////////////////////////////////////////////////////////////////////////////
 
 
 #include "Plane.h"
+#include "Predicates.h"
 #include <iostream>
+
+// допуски PARALLEL_EPSILON и SINGULAR_EPSILON находятся в Intersection.h
+
 // плоскость по умолчанию z = 0 (плоскость по оси XY)
-Plane::Plane() : normal(Vector3(0,0,1)), d(0), normalLength(1), distance(0)
+template<typename T>
+PlaneT<T>::PlaneT() : normal(Vector3T<T>(0,0,1)), d(0), normalLength(1), distance(0)
 {
 }
 
-Plane::Plane(float a, float b, float c, float d)
+template<typename T>
+PlaneT<T>::PlaneT(T a, T b, T c, T d)
 {
     set(a, b, c, d);
 }
 
-Plane::Plane(const Vector3& normal, const Vector3& point)
+template<typename T>
+PlaneT<T>::PlaneT(const Vector3T<T>& normal, const Vector3T<T>& point)
 {
     set(normal, point);
 }
@@ -36,22 +43,25 @@ Plane::Plane(const Vector3& normal, const Vector3& point)
 // выводим себя с 4-мя коэффициентами нормализованного уравнения плоскости
 // aX + bY + cZ + d = 0
 // где (a, b, c) - единичный вектор нормали, d = - (ax0 + by0 + cz0)
-void Plane::printSelf() const
+template<typename T>
+void PlaneT<T>::printSelf() const
 {
     std::cout << "Plane(" << normal.x << ", " << normal.y << ", " << normal.z
             << ", " << d << ")" << std::endl;
 }
 
-void Plane::set(float a, float b, float c, float d)
+template<typename T>
+void PlaneT<T>::set(T a, T b, T c, T d)
 {
     normal.set(a, b, c);
     this->d = d;
     // вычисление расстояния
-    normalLength = sqrtf(a*a + b*b + c*c);
+    normalLength = std::sqrt(a*a + b*b + c*c);
     distance = -d / normalLength;
 }
 
-void Plane::set(const Vector3& normal, const Vector3& point)
+template<typename T>
+void PlaneT<T>::set(const Vector3T<T>& normal, const Vector3T<T>& point)
 {
     this->normal = normal;
     normalLength = normal.length();
@@ -62,17 +72,19 @@ void Plane::set(const Vector3& normal, const Vector3& point)
 // вычисляем кратчайшее расстояние от заданной точки P до плоскости
 // Если расстояние отрицательное, точка находится в противоположной стороне плоскости.
 // D = (a * Px + b * Py + c * Pz + d) / sqrt(a*a + b*b + c*c)
-float Plane::getDistance(const Vector3& point)
+template<typename T>
+T PlaneT<T>::getDistance(const Vector3T<T>& point) const
 {
-    float dot = normal.dot(point);
+    T dot = normal.dot(point);
     return (dot + d) / normalLength;
 }
 
 // нормаль
 // делим каждый коэффициент на длину нормали
-void Plane::normalize()
+template<typename T>
+void PlaneT<T>::normalize()
 {
-    float lengthInv = 1.0f / normalLength;
+    T lengthInv = (T)1 / normalLength;
     normal *= lengthInv;
     normalLength = 1.0f;
     d *= lengthInv;
@@ -87,24 +99,46 @@ void Plane::normalize()
 // a*x0 + a*x*t + b*y0 + b*y*t + c*z0 + c*z*t + d = 0
 // (a*x + b*x + c*x)*t = -(a*x0 + b*y0 + c*z0 + d)
 // t = -(a*x0 + b*y0 + c*z0 + d) / (a*x + b*x + c*x)
-Vector3 Plane::intersect(const Line& line) const
+// статус: параллельна, если знаменатель ~ 0 (правило в Intersection.h);
+// лежит на плоскости, если и числитель ~ 0
+template<typename T>
+PointIntersectionT<T> PlaneT<T>::getIntersection(const LineT<T>& line) const
 {
     // из строки = p + t * v
-    Vector3 p = line.getPoint();        // (x0, y0, z0)
-    Vector3 v = line.getDirection();    // (x,  y,  z)
+    const Vector3T<T>& p = line.getPoint();    // (x0, y0, z0)
+    const Vector3T<T>& v = line.getDirection();// (x,  y,  z)
 
-    float dot1 = normal.dot(p);         // a*x0 + b*y0 + c*z0
-    float dot2 = normal.dot(v);         // a*x + b*y + c*z
+    T dot1 = normal.dot(p);             // a*x0 + b*y0 + c*z0
+    T dot2 = normal.dot(v);             // a*x + b*y + c*z
 
-    // если знаменатель = 0, пересечения нет
-    if(dot2 == 0)
-        return Vector3(NAN, NAN, NAN);
+    // если знаменатель почти 0, пересечения нет
+    if(isNearlyZero(dot2 * dot2, normal.dot(normal) * v.dot(v)))
+    {
+        if(fabs(dot1 + d) <= SINGULAR_EPSILON * (fabs(dot1) + fabs(d)))
+            return PointIntersectionT<T>(INTERSECTION_COINCIDENT);
+        else
+            return PointIntersectionT<T>(INTERSECTION_PARALLEL);
+    }
 
     // исщем t = -(a*x0 + b*y0 + c*z0 + d) / (a*x + b*y + c*z)
-    float t = -(dot1 + d) / dot2;
+    T t = -(dot1 + d) / dot2;
+
+    // находим точку пересечения (если переполнение, считаем параллельной)
+    Vector3T<T> point = mulAdd(t, v, p);
+    if(!isFinite(point))
+        return PointIntersectionT<T>(INTERSECTION_PARALLEL);
+    return PointIntersectionT<T>(point);
+}
 
-    // находим точку пересечения
-    return p + (v * t);
+// то же самое, но возвращает точку с NaN, если пересечения нет
+template<typename T>
+Vector3T<T> PlaneT<T>::intersect(const LineT<T>& line) const
+{
+    PointIntersectionT<T> result = getIntersection(line);
+    if(result.isHit())
+        return result.point;
+    else
+        return Vector3T<T>(NAN, NAN, NAN);
 }
 
 // найти линию пересечения двух плоскостей
@@ -119,49 +153,122 @@ Vector3 Plane::intersect(const Line& line) const
 // P3: V точка p = 0 (выбрано, где d3 = 0)
 // Используем формулу пересечения трех плоскостей, чтобы найти p0;
 // p0 = ((-d1 * N2 + d2 * N1) x V) / V точка V
-Line Plane::intersect(const Plane& rhs) const
+// статус: параллельны или совпадают, если N1 x N2 ~ 0 (правило в Intersection.h)
+template<typename T>
+LineIntersectionT<T> PlaneT<T>::getIntersection(const PlaneT<T>& rhs) const
 {
+    const Vector3T<T>& n2 = rhs.getNormal();
+    T d2 = rhs.getD();
+
     // находим вектор направления линии пересечения
-    Vector3 v = normal.cross(rhs.getNormal());
+    Vector3T<T> v = normal.cross(n2);
+    T dot = v.dot(v);                           // V dot V
+    T dot1 = normal.dot(normal);
+    T dot2 = n2.dot(n2);
+    Vector3T<T> n = mulAdd(d2, normal, -d, n2); // d2*N1 - d1*N2
 
-    // если |direction| = 0, две плоскости параллельны (не пересекаются)
-    // возвращаем строку с NaN
-    if(v.x == 0 && v.y == 0 && v.z == 0)
-        return Line(Vector3(NAN, NAN, NAN), Vector3(NAN, NAN, NAN));
+    // если N1 x N2 почти 0, две плоскости параллельны (не пересекаются),
+    // и совпадают, если также d2*N1 - d1*N2 ~ 0
+    if(isNearlyZero(dot, dot1 * dot2))
+    {
+        if(isNearlyZero(n.dot(n), d2 * d2 * dot1 + d * d * dot2))
+            return LineIntersectionT<T>(INTERSECTION_COINCIDENT);
+        else
+            return LineIntersectionT<T>(INTERSECTION_PARALLEL);
+    }
 
     // находим точку на линии, которая также находится в обеих плоскостях
     // выбираем простую плоскость, где d = 0: ax + by + cz = 0
-    float dot = v.dot(v);                       // V dot V
-    Vector3 n1 = rhs.getD() * normal;           // d2 * N1
-    Vector3 n2 = -d * rhs.getNormal();          //-d1 * N2
-    Vector3 p = (n1 + n2).cross(v) / dot;       // (d2*N1-d1*N2) X V / V dot V
+    Vector3T<T> p = crossScale(n, v, 1 / dot);  // (d2*N1-d1*N2) X V / V dot V
+    if(!isFinite(v) || !isFinite(p))
+        return LineIntersectionT<T>(INTERSECTION_PARALLEL);   // переполнение
 
-    return Line(v, p);
+    return LineIntersectionT<T>(LineT<T>(v, p));
 }
 
-//определить, пересекается ли он с линией
-bool Plane::isIntersected(const Line& line) const
+// то же самое, но возвращает строку с NaN, если плоскости параллельны
+template<typename T>
+LineT<T> PlaneT<T>::intersect(const PlaneT<T>& rhs) const
+{
+    LineIntersectionT<T> result = getIntersection(rhs);
+    if(result.isHit())
+        return result.line;
+    else
+        return LineT<T>(Vector3T<T>(NAN, NAN, NAN), Vector3T<T>(NAN, NAN, NAN));
+}
+
+// найти точку пересечения трех плоскостей
+// P1: N1 точка p + d1 = 0
+// P2: N2 точка p + d2 = 0
+// P3: N3 точка p + d3 = 0
+// det = N1 точка (N2 x N3) (смешанное произведение)
+// p = -(d1 * (N2 x N3) + d2 * (N3 x N1) + d3 * (N1 x N2)) / det
+// если det = 0 (с учетом погрешности), единственной точки нет (статус "параллельны")
+template<typename T>
+PointIntersectionT<T> PlaneT<T>::getIntersection(const PlaneT<T>& plane2, const PlaneT<T>& plane3) const
 {
-    // вектор направления линии
-    Vector3 v = line.getDirection();
+    const Vector3T<T>& n2 = plane2.getNormal();
+    const Vector3T<T>& n3 = plane3.getNormal();
+    Vector3T<T> u = n2.cross(n3);               // N2 x N3
 
-    // скалярное произведение с нормалью к плоскости
-    float dot = normal.dot(v);  // a*Vx + b*Vy + c*Vz
+    T det = normal.dot(u);
+    if(fabs(det) <= SINGULAR_EPSILON * normalLength * plane2.getNormalLength() * plane3.getNormalLength())
+        return PointIntersectionT<T>(INTERSECTION_PARALLEL);
 
-    if(dot == 0)
-        return false;
+    Vector3T<T> v = n3.cross(normal);           // N3 x N1
+    Vector3T<T> w = normal.cross(n2);           // N1 x N2
+    Vector3T<T> p = (d * u + plane2.getD() * v + plane3.getD() * w) / -det;
+    if(!isFinite(p))
+        return PointIntersectionT<T>(INTERSECTION_PARALLEL);  // переполнение
+    return PointIntersectionT<T>(p);
+}
+
+// то же самое, но возвращает точку с NaN, если единственной точки нет
+template<typename T>
+Vector3T<T> PlaneT<T>::intersect(const PlaneT<T>& plane2, const PlaneT<T>& plane3) const
+{
+    PointIntersectionT<T> result = getIntersection(plane2, plane3);
+    if(result.isHit())
+        return result.point;
     else
-        return true;
+        return Vector3T<T>(NAN, NAN, NAN);
+}
+
+//определить, пересекается ли он с линией
+template<typename T>
+bool PlaneT<T>::isIntersected(const LineT<T>& line) const
+{
+    // скалярное произведение с нормалью к плоскости: a*Vx + b*Vy + c*Vz,
+    // не почти 0
+    const Vector3T<T>& v = line.getDirection();
+    T dot = normal.dot(v);
+    return !isNearlyZero(dot * dot, normal.dot(normal) * v.dot(v));
 }
 
 // определить, пересекается ли он с другой плоскостью
-bool Plane::isIntersected(const Plane& plane) const
+template<typename T>
+bool PlaneT<T>::isIntersected(const PlaneT<T>& plane) const
 {
     // check if 2 plane normals are same direction
-    // проверяем, совпадают ли направления нормали 2 плоскостей
-    Vector3 cross = normal.cross(plane.getNormal());
-    if(cross.x == 0 && cross.y == 0 && cross.z == 0)
-        return false;
-    else
-        return true;
+    // проверяем, совпадают ли направления нормали 2 плоскостей (или почти)
+    const Vector3T<T>& n2 = plane.getNormal();
+    Vector3T<T> v = normal.cross(n2);
+    return !isNearlyZero(v.dot(v), normal.dot(normal) * n2.dot(n2));
+}
+
+// определить, совпадает ли плоскость с другой плоскостью
+// нормали параллельны и коэффициенты пропорциональны: d1 * N2 = d2 * N1
+template<typename T>
+bool PlaneT<T>::isCoplanar(const PlaneT<T>& plane) const
+{
+    const Vector3T<T>& n2 = plane.getNormal();
+    T d2 = plane.getD();
+    return isParallel(normal, n2) &&
+           det2Sign(d, normal.x, d2, n2.x) == 0 &&
+           det2Sign(d, normal.y, d2, n2.y) == 0 &&
+           det2Sign(d, normal.z, d2, n2.z) == 0;
 }
+
+// создаем версии float и double
+template class PlaneT<float>;
+template class PlaneT<double>;
@@ -7,12 +7,21 @@
 // NOTE:
 // 1. The default plane is z = 0 (a plane on XY axis)
 // 2. The distance is the length from the origin to the plane
+// 3. PlaneT<T> is a template of the element type, float or double. Plane is
+//    the float version and Planed is the double version. Both are
+//    instantiated in Plane.cpp.
+// 4. isIntersected() and getIntersection() treat nearly parallel planes/lines
+//    as parallel by the tolerance rule of Intersection.h. isCoplanar() uses
+//    the exact sign tests in Predicates, so it is true only for exactly the
+//    same planes.
+// 5. getIntersection() returns the point/line with a status (hit, parallel or
+//    coincident) instead of NaN. intersect() returns NaN if the status is not hit.
 //
-// Dependencies: Vector3, Line
+// Dependencies: Vector3, Line, Intersection
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-01-19
-// UPDATED: 2016-04-14
+// UPDATED: 2026-10-17
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef PLANE_H_DEF
@@ -20,44 +29,56 @@
 
 #include "Vectors.h"
 #include "Line.h"
+#include "Intersection.h"
 
-class Plane
+template<typename T>
+class PlaneT
 {
 public:
     // ctor/dtor
-    Plane();
-    Plane(float a, float b, float c, float d);          // 4 coeff of plane equation
-    Plane(const Vector3& normal, const Vector3& point); // a point on the plane and normal vector
-    ~Plane() {}
+    PlaneT();
+    PlaneT(T a, T b, T c, T d);                                     // 4 coeff of plane equation
+    PlaneT(const Vector3T<T>& normal, const Vector3T<T>& point);    // a point on the plane and normal vector
+    ~PlaneT() {}
 
     // debug
     void printSelf() const;
 
     // setters/getters
-    void set(float a, float b, float c, float d);
-    void set(const Vector3& normal, const Vector3& point);  // set with  a point on the plane and normal
-    const Vector3& getNormal() const { return normal; }
-    float getD() const { return d; }                        // return 4th coefficient
-    float getNormalLength() const { return normalLength; }  // return length of normal
-    float getDistance() const { return distance; };         // return distance from the origin
-    float getDistance(const Vector3& point);                // return distance from the point
+    void set(T a, T b, T c, T d);
+    void set(const Vector3T<T>& normal, const Vector3T<T>& point);  // set with  a point on the plane and normal
+    const Vector3T<T>& getNormal() const { return normal; }
+    T getD() const { return d; }                                    // return 4th coefficient
+    T getNormalLength() const { return normalLength; }              // return length of normal
+    T getDistance() const { return distance; };                     // return distance from the origin
+    T getDistance(const Vector3T<T>& point) const;                  // return distance from the point
 
     // convert plane equation with unit normal vector
     void normalize();
 
     // for intersection
-    Vector3 intersect(const Line& line) const;              // intersect with a line
-    Line intersect(const Plane& plane) const;               // intersect with another plane
-    bool isIntersected(const Line& line) const;
-    bool isIntersected(const Plane& plane) const;
+    Vector3T<T> intersect(const LineT<T>& line) const;              // intersect with a line
+    LineT<T> intersect(const PlaneT& plane) const;                  // intersect with another plane
+    Vector3T<T> intersect(const PlaneT& plane2, const PlaneT& plane3) const; // intersect with 2 other planes
+    bool isIntersected(const LineT<T>& line) const;
+    bool isIntersected(const PlaneT& plane) const;
+    bool isCoplanar(const PlaneT& plane) const;                     // same plane
+
+    // for intersection with status
+    PointIntersectionT<T> getIntersection(const LineT<T>& line) const;
+    LineIntersectionT<T> getIntersection(const PlaneT& plane) const;
+    PointIntersectionT<T> getIntersection(const PlaneT& plane2, const PlaneT& plane3) const;
 
 protected:
 
 private:
-    Vector3 normal;     // normal vector of a plane
-    float d;            // coefficient of constant term: d = -(a*x0 + b*y0 + c*z0)
-    float normalLength; // length of normal vector
-    float distance;     // distance from origin to plane
+    Vector3T<T> normal; // normal vector of a plane
+    T d;                // coefficient of constant term: d = -(a*x0 + b*y0 + c*z0)
+    T normalLength;     // length of normal vector
+    T distance;         // distance from origin to plane
 };
 
+typedef PlaneT<float>  Plane;
+typedef PlaneT<double> Planed;
+
 #endif
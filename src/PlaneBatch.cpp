@@ -0,0 +1,524 @@
+///////////////////////////////////////////////////////////////////////////////
+// PlaneBatch.cpp
+// ==============
+// a set of 3D planes stored as structure of arrays (SoA) for batch kernels
+// ax + by + cz + d = 0, each coefficient is stored in a separate array
+//
+// Dependencies: Plane, LineBatch, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include "PlaneBatch.h"
+
+
+
+// constants //////////////////////////////////////////////////////////////////
+// # of planes per tile for intersectAll(), a plane takes 16 bytes (a,b,c,d)
+const int ROW_BLOCK_SIZE    = 8192;     // 128 KB, stays in L2 cache
+const int COLUMN_BLOCK_SIZE = 1024;     //  16 KB, stays in L1 cache
+const int ROW_CHUNK_SIZE    = 256;      // # of rows per task on a thread pool
+
+// (SINGULAR_EPSILON and PARALLEL_EPSILON are in Intersection.h)
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor with an array of Plane
+///////////////////////////////////////////////////////////////////////////////
+PlaneBatch::PlaneBatch(const Plane* planes, int count)
+{
+    resize(count);
+    for(int i = 0; i < count; ++i)
+        set(i, planes[i]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// resize/reserve/clear all arrays at once
+///////////////////////////////////////////////////////////////////////////////
+void PlaneBatch::resize(int count)
+{
+    a.resize(count);  b.resize(count);  c.resize(count);  d.resize(count);
+}
+
+void PlaneBatch::reserve(int count)
+{
+    a.reserve(count);  b.reserve(count);  c.reserve(count);  d.reserve(count);
+}
+
+void PlaneBatch::clear()
+{
+    a.clear();  b.clear();  c.clear();  d.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// setters/getters
+///////////////////////////////////////////////////////////////////////////////
+void PlaneBatch::add(const Plane& plane)
+{
+    const Vector3& n = plane.getNormal();
+    add(n.x, n.y, n.z, plane.getD());
+}
+
+void PlaneBatch::add(float a, float b, float c, float d)
+{
+    this->a.push_back(a);
+    this->b.push_back(b);
+    this->c.push_back(c);
+    this->d.push_back(d);
+}
+
+void PlaneBatch::set(int index, const Plane& plane)
+{
+    const Vector3& n = plane.getNormal();
+    set(index, n.x, n.y, n.z, plane.getD());
+}
+
+void PlaneBatch::set(int index, float a, float b, float c, float d)
+{
+    this->a[index] = a;
+    this->b[index] = b;
+    this->c[index] = c;
+    this->d[index] = d;
+}
+
+Plane PlaneBatch::get(int index) const
+{
+    return Plane(a[index], b[index], c[index], d[index]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the intersection lines of i-th planes of this and rhs, SIMD_WIDTH pairs
+// at once. It uses the same formula as Plane::intersect(const Plane&)
+// V  = N1 x N2
+// p0 = (d2*N1 - d1*N2) x V / V dot V
+//
+// The status of a parallel pair (V ~ 0) is INTERSECTION_PARALLEL, or
+// INTERSECTION_COINCIDENT if U = d2*N1 - d1*N2 is also ~ 0, and its line is
+// set to all zero. Otherwise the status is INTERSECTION_HIT. The rules of
+// parallel and coincident are same as Plane::getIntersection(const Plane&),
+// see Intersection.h.
+// Return the number of intersected pairs.
+///////////////////////////////////////////////////////////////////////////////
+int PlaneBatch::intersect(const PlaneBatch& rhs, LineBatch& lines,
+                          std::vector<unsigned char>& status, ThreadPool* pool) const
+{
+    int count = std::min(size(), rhs.size());
+    lines.resize(count);
+    status.resize(count);
+
+    const float *a1 = getA(), *b1 = getB(), *c1 = getC(), *d1 = getD();
+    const float *a2 = rhs.getA(), *b2 = rhs.getB(), *c2 = rhs.getC(), *d2 = rhs.getD();
+    float *vx = lines.getDirectionX(), *vy = lines.getDirectionY(), *vz = lines.getDirectionZ();
+    float *px = lines.getPointX(), *py = lines.getPointY(), *pz = lines.getPointZ();
+    const SimdFloat one = simdSet(1.0f);
+    const SimdFloat epsilon = simdSet(PARALLEL_EPSILON);
+
+    std::atomic<int> hitCount(0);
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        int localCount = 0;
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;      // # of valid lanes (the last one may be partial)
+            SimdFloat na1 = simdLoadN(a1 + i, n), nb1 = simdLoadN(b1 + i, n), nc1 = simdLoadN(c1 + i, n), nd1 = simdLoadN(d1 + i, n);
+            SimdFloat na2 = simdLoadN(a2 + i, n), nb2 = simdLoadN(b2 + i, n), nc2 = simdLoadN(c2 + i, n), nd2 = simdLoadN(d2 + i, n);
+
+            // direction vector V = N1 x N2
+            SimdFloat x = simdSub(simdMul(nb1, nc2), simdMul(nc1, nb2));
+            SimdFloat y = simdSub(simdMul(nc1, na2), simdMul(na1, nc2));
+            SimdFloat z = simdSub(simdMul(na1, nb2), simdMul(nb1, na2));
+
+            // if V ~ 0, 2 planes are parallel (no intersection)
+            SimdFloat dot = simdAdd(simdAdd(simdMul(x, x), simdMul(y, y)), simdMul(z, z));
+            SimdFloat dot1 = simdAdd(simdAdd(simdMul(na1, na1), simdMul(nb1, nb1)), simdMul(nc1, nc1));
+            SimdFloat dot2 = simdAdd(simdAdd(simdMul(na2, na2), simdMul(nb2, nb2)), simdMul(nc2, nc2));
+            SimdFloat parallel = simdIsNearlyZero(dot, simdMul(dot1, dot2), epsilon);
+            SimdFloat hit = simdAndNot(parallel, simdTrue());
+
+            // U = d2*N1 - d1*N2
+            SimdFloat ux = simdSub(simdMul(nd2, na1), simdMul(nd1, na2));
+            SimdFloat uy = simdSub(simdMul(nd2, nb1), simdMul(nd1, nb2));
+            SimdFloat uz = simdSub(simdMul(nd2, nc1), simdMul(nd1, nc2));
+
+            // p0 = U x V / V dot V, zero for parallel pairs instead of NaN
+            SimdFloat invDot = simdAnd(hit, simdDiv(one, dot));
+            SimdFloat ox = simdMul(simdSub(simdMul(uy, z), simdMul(uz, y)), invDot);
+            SimdFloat oy = simdMul(simdSub(simdMul(uz, x), simdMul(ux, z)), invDot);
+            SimdFloat oz = simdMul(simdSub(simdMul(ux, y), simdMul(uy, x)), invDot);
+
+            // a hit must be finite, the overflowed pairs are parallel
+            SimdFloat finite = simdAnd(simdAnd(simdIsFinite(ox), simdIsFinite(oy)), simdIsFinite(oz));
+            parallel = simdOr(parallel, simdAndNot(finite, simdTrue()));
+            hit = simdAnd(hit, finite);
+            ox = simdAnd(hit, ox);
+            oy = simdAnd(hit, oy);
+            oz = simdAnd(hit, oz);
+
+            simdStoreN(vx + i, x, n);   simdStoreN(vy + i, y, n);   simdStoreN(vz + i, z, n);
+            simdStoreN(px + i, ox, n);  simdStoreN(py + i, oy, n);  simdStoreN(pz + i, oz, n);
+
+            // same planes if U ~ 0 too,
+            // |U|^2 <= e * (d2^2*|N1|^2 + d1^2*|N2|^2)
+            SimdFloat uu = simdAdd(simdAdd(simdMul(ux, ux), simdMul(uy, uy)), simdMul(uz, uz));
+            SimdFloat scale = simdAdd(simdMul(simdMul(nd2, nd2), dot1), simdMul(simdMul(nd1, nd1), dot2));
+            SimdFloat same = simdIsNearlyZero(uu, scale, epsilon);
+            int bits = simdMoveMask(hit);
+            int coincidentBits = simdMoveMask(simdAnd(parallel, same));
+            simdStoreMaskN(&status[i], bits, n);
+            simdStoreCodeN(&status[i], ~bits & ~coincidentBits, INTERSECTION_PARALLEL, n);
+            simdStoreCodeN(&status[i], coincidentBits, INTERSECTION_COINCIDENT, n);
+            localCount += simdCountBits(bits);
+        }
+        hitCount += localCount;
+    }, SIMD_WIDTH);
+
+    return hitCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the intersection points of i-th planes of this, rhs1 and rhs2,
+// SIMD_WIDTH triples at once. It uses the same formula as
+// Plane::intersect(const Plane&, const Plane&)
+// det = N1 dot (N2 x N3)
+// (singular if det^2 <= e^2 * |N1|^2 * |N2|^2 * |N3|^2)
+// p   = -(d1*(N2 x N3) + d2*(N3 x N1) + d3*(N1 x N2)) / det
+//
+// The status of a singular triple (det ~ 0, 2 or more planes are parallel, or
+// all 3 share a line) is INTERSECTION_PARALLEL and its point is set to all
+// zero, otherwise the status is INTERSECTION_HIT.
+// Return the number of intersected triples.
+///////////////////////////////////////////////////////////////////////////////
+int PlaneBatch::intersect(const PlaneBatch& rhs1, const PlaneBatch& rhs2,
+                          FloatArray& x, FloatArray& y, FloatArray& z,
+                          std::vector<unsigned char>& status, ThreadPool* pool) const
+{
+    int count = std::min(size(), std::min(rhs1.size(), rhs2.size()));
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    status.resize(count);
+
+    const float *a1 = getA(), *b1 = getB(), *c1 = getC(), *d1 = getD();
+    const float *a2 = rhs1.getA(), *b2 = rhs1.getB(), *c2 = rhs1.getC(), *d2 = rhs1.getD();
+    const float *a3 = rhs2.getA(), *b3 = rhs2.getB(), *c3 = rhs2.getC(), *d3 = rhs2.getD();
+    const SimdFloat epsilonSq = simdSet(SINGULAR_EPSILON * SINGULAR_EPSILON);
+    const SimdFloat minusOne = simdSet(-1.0f);
+
+    std::atomic<int> hitCount(0);
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        int localCount = 0;
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat na1 = simdLoadN(a1 + i, n), nb1 = simdLoadN(b1 + i, n), nc1 = simdLoadN(c1 + i, n);
+            SimdFloat na2 = simdLoadN(a2 + i, n), nb2 = simdLoadN(b2 + i, n), nc2 = simdLoadN(c2 + i, n);
+            SimdFloat na3 = simdLoadN(a3 + i, n), nb3 = simdLoadN(b3 + i, n), nc3 = simdLoadN(c3 + i, n);
+
+            // N2 x N3, N3 x N1, N1 x N2
+            SimdFloat ux = simdSub(simdMul(nb2, nc3), simdMul(nc2, nb3));
+            SimdFloat uy = simdSub(simdMul(nc2, na3), simdMul(na2, nc3));
+            SimdFloat uz = simdSub(simdMul(na2, nb3), simdMul(nb2, na3));
+            SimdFloat vx = simdSub(simdMul(nb3, nc1), simdMul(nc3, nb1));
+            SimdFloat vy = simdSub(simdMul(nc3, na1), simdMul(na3, nc1));
+            SimdFloat vz = simdSub(simdMul(na3, nb1), simdMul(nb3, na1));
+            SimdFloat wx = simdSub(simdMul(nb1, nc2), simdMul(nc1, nb2));
+            SimdFloat wy = simdSub(simdMul(nc1, na2), simdMul(na1, nc2));
+            SimdFloat wz = simdSub(simdMul(na1, nb2), simdMul(nb1, na2));
+
+            // triple product, singular if about 0 (padded lanes have N = 0)
+            SimdFloat det = simdAdd(simdAdd(simdMul(na1, ux), simdMul(nb1, uy)), simdMul(nc1, uz));
+            SimdFloat lenSq1 = simdAdd(simdAdd(simdMul(na1, na1), simdMul(nb1, nb1)), simdMul(nc1, nc1));
+            SimdFloat lenSq2 = simdAdd(simdAdd(simdMul(na2, na2), simdMul(nb2, nb2)), simdMul(nc2, nc2));
+            SimdFloat lenSq3 = simdAdd(simdAdd(simdMul(na3, na3), simdMul(nb3, nb3)), simdMul(nc3, nc3));
+            SimdFloat limit = simdMul(simdMul(epsilonSq, lenSq1), simdMul(lenSq2, lenSq3));
+            SimdFloat hit = simdCmpGt(simdMul(det, det), limit);
+
+            // -1 / det, zero for singular triples instead of NaN
+            SimdFloat invDet = simdAnd(hit, simdDiv(minusOne, det));
+            SimdFloat nd1 = simdLoadN(d1 + i, n), nd2 = simdLoadN(d2 + i, n), nd3 = simdLoadN(d3 + i, n);
+            SimdFloat px = simdAdd(simdAdd(simdMul(nd1, ux), simdMul(nd2, vx)), simdMul(nd3, wx));
+            SimdFloat py = simdAdd(simdAdd(simdMul(nd1, uy), simdMul(nd2, vy)), simdMul(nd3, wy));
+            SimdFloat pz = simdAdd(simdAdd(simdMul(nd1, uz), simdMul(nd2, vz)), simdMul(nd3, wz));
+
+            // a hit must be finite, the overflowed triples are singular
+            px = simdMul(px, invDet);
+            py = simdMul(py, invDet);
+            pz = simdMul(pz, invDet);
+            hit = simdAnd(hit, simdAnd(simdAnd(simdIsFinite(px), simdIsFinite(py)), simdIsFinite(pz)));
+
+            simdStoreN(&x[i], simdAnd(hit, px), n);
+            simdStoreN(&y[i], simdAnd(hit, py), n);
+            simdStoreN(&z[i], simdAnd(hit, pz), n);
+
+            int bits = simdMoveMask(hit);
+            simdStoreMaskN(&status[i], bits, n);
+            simdStoreCodeN(&status[i], ~bits, INTERSECTION_PARALLEL, n);
+            localCount += simdCountBits(bits);
+        }
+        hitCount += localCount;
+    }, SIMD_WIDTH);
+
+    return hitCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the intersection of a line with all planes, SIMD_WIDTH planes at once.
+// It uses the same formula as Plane::intersect(const Line&), but returns the
+// parameter t of the intersection point (p + tV) instead of the point.
+// t = -(a*x0 + b*y0 + c*z0 + d) / (a*x + b*y + c*z)
+//
+// The status is INTERSECTION_HIT if the line hits the plane within
+// [tMin, tMax], INTERSECTION_NONE if t is out of range, INTERSECTION_PARALLEL
+// or INTERSECTION_COINCIDENT (the line is on the plane) if the line is
+// parallel to the plane (or t overflows, a hit is always finite). The rules
+// of parallel and coincident are same as Plane::getIntersection(const Line&),
+// see Intersection.h. t of a non-hit plane is set to 0.
+// Return the number of hits.
+///////////////////////////////////////////////////////////////////////////////
+int PlaneBatch::intersect(const Line& line, std::vector<float>& t,
+                          std::vector<unsigned char>& status, float tMin, float tMax,
+                          ThreadPool* pool) const
+{
+    int count = size();
+    t.resize(count);
+    status.resize(count);
+
+    // line = p + tV, same for all lanes
+    const Vector3& p = line.getPoint();
+    const Vector3& v = line.getDirection();
+    const SimdFloat x0 = simdSet(p.x), y0 = simdSet(p.y), z0 = simdSet(p.z);
+    const SimdFloat x = simdSet(v.x), y = simdSet(v.y), z = simdSet(v.z);
+    const SimdFloat lengthSq = simdSet(v.dot(v));
+    const SimdFloat epsilon = simdSet(PARALLEL_EPSILON);
+    const SimdFloat singular = simdSet(SINGULAR_EPSILON);
+    const SimdFloat signBit = simdSet(-0.0f);
+    const SimdFloat lower = simdSet(tMin);
+    const SimdFloat upper = simdSet(tMax);
+    const SimdFloat zero = simdZero();
+
+    std::atomic<int> hitCount(0);
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        int localCount = 0;
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat na = simdLoadN(&a[i], n), nb = simdLoadN(&b[i], n), nc = simdLoadN(&c[i], n);
+            SimdFloat nd = simdLoadN(&d[i], n);
+            SimdFloat np = simdAdd(simdAdd(simdMul(na, x0), simdMul(nb, y0)), simdMul(nc, z0));  // a*x0 + b*y0 + c*z0
+            SimdFloat dot1 = simdAdd(np, nd);                                               // a*x0 + b*y0 + c*z0 + d
+            SimdFloat dot2 = simdAdd(simdAdd(simdMul(na, x), simdMul(nb, y)), simdMul(nc, z));    // a*x + b*y + c*z
+
+            // parallel if dot2^2 <= e * |N|^2 * |V|^2 (see Intersection.h)
+            SimdFloat normalSq = simdAdd(simdAdd(simdMul(na, na), simdMul(nb, nb)), simdMul(nc, nc));
+            SimdFloat parallel = simdIsNearlyZero(simdMul(dot2, dot2), simdMul(normalSq, lengthSq), epsilon);
+
+            // hit if not parallel and tMin <= t <= tMax
+            // (s must be finite, it overflows if dot2 is tiny)
+            SimdFloat s = simdDiv(simdSub(zero, dot1), dot2);
+            parallel = simdOr(parallel, simdAndNot(simdIsFinite(s), simdTrue()));
+            SimdFloat hit = simdAndNot(parallel, simdAnd(simdCmpGe(s, lower), simdCmpLe(s, upper)));
+
+            // on the plane if |N.p + d| <= e * (|N.p| + |d|)
+            SimdFloat limit = simdMul(singular, simdAdd(simdAndNot(signBit, np), simdAndNot(signBit, nd)));
+            SimdFloat onPlane = simdCmpLe(simdAndNot(signBit, dot1), limit);
+
+            simdStoreN(&t[i], simdAnd(hit, s), n);
+            int bits = simdMoveMask(hit);   // padded lanes have N = 0, never hit
+            int parallelBits = simdMoveMask(parallel);
+            int coincidentBits = simdMoveMask(simdAnd(parallel, onPlane));
+            simdStoreMaskN(&status[i], bits, n);    // INTERSECTION_HIT or NONE
+            simdStoreCodeN(&status[i], parallelBits & ~coincidentBits, INTERSECTION_PARALLEL, n);
+            simdStoreCodeN(&status[i], coincidentBits, INTERSECTION_COINCIDENT, n);
+            localCount += simdCountBits(bits);
+        }
+        hitCount += localCount;
+    }, SIMD_WIDTH);
+
+    return hitCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the intersection lines of all pairs (i, j), i < j, in this set.
+// The pairs are processed tile by tile; a tile of ROW_BLOCK_SIZE planes (i) is
+// kept in L2 cache while it is tested against the tiles of COLUMN_BLOCK_SIZE
+// planes (j), which are kept in L1 cache. Plane i is broadcast to all lanes
+// and tested against SIMD_WIDTH planes of j at once.
+//
+// The parallel test of Plane::isIntersected() (V = N1 x N2 ~ 0, see
+// Intersection.h) is done in the same pass, and only the intersected lines
+// are appended to lines, with indices1[k] = i, indices2[k] = j. The index
+// arrays are resized to match lines. Return the number of appended lines.
+//
+// With a thread pool, the rows (i) are split into chunks of ROW_CHUNK_SIZE.
+// Each chunk writes its own lines, then they are joined in row order.
+///////////////////////////////////////////////////////////////////////////////
+int PlaneBatch::intersectAll(LineBatch& lines, std::vector<int>& indices1,
+                             std::vector<int>& indices2, ThreadPool* pool) const
+{
+    const int count = size();
+    if(!pool || pool->getThreadCount() == 1)
+        return intersectRows(0, count, lines, indices1, indices2);
+
+    int chunkCount = (count + ROW_CHUNK_SIZE - 1) / ROW_CHUNK_SIZE;
+    std::vector<LineBatch> chunkLines(chunkCount);
+    std::vector<std::vector<int> > chunkIndices1(chunkCount), chunkIndices2(chunkCount);
+    pool->parallelFor(0, count, ROW_CHUNK_SIZE, [&](int first, int last)
+    {
+        int k = first / ROW_CHUNK_SIZE;
+        intersectRows(first, last, chunkLines[k], chunkIndices1[k], chunkIndices2[k]);
+    });
+
+    // join the outputs of chunks after the existing lines
+    int first = lines.size();
+    int total = 0;
+    for(int k = 0; k < chunkCount; ++k)
+        total += chunkLines[k].size();
+    lines.resize(first + total);
+    indices1.resize(first + total);
+    indices2.resize(first + total);
+
+    int last = first;
+    for(int k = 0; k < chunkCount; ++k)
+    {
+        const LineBatch& src = chunkLines[k];
+        int n = src.size();
+        std::copy(src.getDirectionX(), src.getDirectionX() + n, lines.getDirectionX() + last);
+        std::copy(src.getDirectionY(), src.getDirectionY() + n, lines.getDirectionY() + last);
+        std::copy(src.getDirectionZ(), src.getDirectionZ() + n, lines.getDirectionZ() + last);
+        std::copy(src.getPointX(), src.getPointX() + n, lines.getPointX() + last);
+        std::copy(src.getPointY(), src.getPointY() + n, lines.getPointY() + last);
+        std::copy(src.getPointZ(), src.getPointZ() + n, lines.getPointZ() + last);
+        std::copy(chunkIndices1[k].begin(), chunkIndices1[k].end(), indices1.begin() + last);
+        std::copy(chunkIndices2[k].begin(), chunkIndices2[k].end(), indices2.begin() + last);
+        last += n;
+    }
+
+    return total;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the intersection lines of the pairs (i, j) for rows first <= i < last
+// and i < j < size(), and append them to lines (see intersectAll())
+///////////////////////////////////////////////////////////////////////////////
+int PlaneBatch::intersectRows(int rowFirst, int rowLast, LineBatch& lines,
+                              std::vector<int>& indices1, std::vector<int>& indices2) const
+{
+    const int count = size();
+    const float *pa = getA(), *pb = getB(), *pc = getC(), *pd = getD();
+    const SimdFloat one = simdSet(1.0f);
+    const SimdFloat epsilon = simdSet(PARALLEL_EPSILON);
+    float x[SIMD_WIDTH], y[SIMD_WIDTH], z[SIMD_WIDTH];      // lane outputs
+    float ox[SIMD_WIDTH], oy[SIMD_WIDTH], oz[SIMD_WIDTH];
+
+    // outputs are appended after the existing lines, and grown by blocks
+    // instead of push_back() per element
+    int first = lines.size();
+    indices1.resize(first);
+    indices2.resize(first);
+    int last = first;                       // end of appended lines
+    int capacity = first;
+
+    for(int rowBlock = rowFirst; rowBlock < rowLast; rowBlock += ROW_BLOCK_SIZE)
+    {
+        int rowEnd = std::min(rowBlock + ROW_BLOCK_SIZE, rowLast);
+
+        for(int colBlock = rowBlock; colBlock < count; colBlock += COLUMN_BLOCK_SIZE)
+        {
+            int colEnd = std::min(colBlock + COLUMN_BLOCK_SIZE, count);
+
+            for(int i = rowBlock; i < rowEnd; ++i)
+            {
+                // make enough room for the worst case of this row (all hit)
+                if(last + COLUMN_BLOCK_SIZE > capacity)
+                {
+                    capacity = std::max(capacity * 2, last + ROW_BLOCK_SIZE);
+                    lines.resize(capacity);
+                    indices1.resize(capacity);
+                    indices2.resize(capacity);
+                }
+                float *vx = lines.getDirectionX(), *vy = lines.getDirectionY(), *vz = lines.getDirectionZ();
+                float *px = lines.getPointX(), *py = lines.getPointY(), *pz = lines.getPointZ();
+
+                // plane i is same for all lanes
+                SimdFloat a1 = simdSet(pa[i]), b1 = simdSet(pb[i]), c1 = simdSet(pc[i]), d1 = simdSet(pd[i]);
+                SimdFloat lengthSq1 = simdSet(pa[i] * pa[i] + pb[i] * pb[i] + pc[i] * pc[i]);
+
+                for(int j = std::max(colBlock, i + 1); j < colEnd; j += SIMD_WIDTH)
+                {
+                    int n = colEnd - j;
+                    SimdFloat a2 = simdLoadN(pa + j, n), b2 = simdLoadN(pb + j, n);
+                    SimdFloat c2 = simdLoadN(pc + j, n), d2 = simdLoadN(pd + j, n);
+
+                    // V = N1 x N2
+                    SimdFloat dx = simdSub(simdMul(b1, c2), simdMul(c1, b2));
+                    SimdFloat dy = simdSub(simdMul(c1, a2), simdMul(a1, c2));
+                    SimdFloat dz = simdSub(simdMul(a1, b2), simdMul(b1, a2));
+
+                    // skip if all pairs are parallel (V ~ 0)
+                    SimdFloat dot = simdAdd(simdAdd(simdMul(dx, dx), simdMul(dy, dy)), simdMul(dz, dz));
+                    SimdFloat lengthSq2 = simdAdd(simdAdd(simdMul(a2, a2), simdMul(b2, b2)), simdMul(c2, c2));
+                    SimdFloat hit = simdAndNot(simdIsNearlyZero(dot, simdMul(lengthSq1, lengthSq2), epsilon),
+                                               simdTrue());
+                    int bits = simdMoveMask(hit);
+                    if(!bits)
+                        continue;
+
+                    // p0 = (d2*N1 - d1*N2) x V / V dot V
+                    SimdFloat ux = simdSub(simdMul(d2, a1), simdMul(d1, a2));
+                    SimdFloat uy = simdSub(simdMul(d2, b1), simdMul(d1, b2));
+                    SimdFloat uz = simdSub(simdMul(d2, c1), simdMul(d1, c2));
+                    SimdFloat invDot = simdDiv(one, dot);
+                    SimdFloat qx = simdMul(simdSub(simdMul(uy, dz), simdMul(uz, dy)), invDot);
+                    SimdFloat qy = simdMul(simdSub(simdMul(uz, dx), simdMul(ux, dz)), invDot);
+                    SimdFloat qz = simdMul(simdSub(simdMul(ux, dy), simdMul(uy, dx)), invDot);
+                    simdStore(x, dx);  simdStore(y, dy);  simdStore(z, dz);
+                    simdStore(ox, qx);  simdStore(oy, qy);  simdStore(oz, qz);
+
+                    // a hit must be finite
+                    hit = simdAnd(hit, simdAnd(simdAnd(simdIsFinite(qx), simdIsFinite(qy)), simdIsFinite(qz)));
+                    bits = simdMoveMask(hit);
+
+                    // compact: write intersected lanes only
+                    // (the padded lanes of a partial vector are 0, so never hit)
+                    for(int k = 0; bits; ++k, bits >>= 1)
+                    {
+                        if(!(bits & 1))
+                            continue;
+                        vx[last] = x[k];   vy[last] = y[k];   vz[last] = z[k];
+                        px[last] = ox[k];  py[last] = oy[k];  pz[last] = oz[k];
+                        indices1[last] = i;
+                        indices2[last] = j + k;
+                        ++last;
+                    }
+                }
+            }
+        }
+    }
+
+    // trim unused room
+    lines.resize(last);
+    indices1.resize(last);
+    indices2.resize(last);
+
+    return last - first;
+}
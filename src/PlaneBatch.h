@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// PlaneBatch.h
+// ============
+// a set of 3D planes stored as structure of arrays (SoA) for batch kernels
+// ax + by + cz + d = 0, each coefficient is stored in a separate array
+//
+// NOTE:
+// 1. All arrays are aligned at SIMD_ALIGNMENT bytes.
+// 2. The batch intersect functions process SIMD_WIDTH pairs at once, and
+//    return a status array (1 byte per pair, see Intersection.h) instead of
+//    NaN: INTERSECTION_HIT if the pair intersects, INTERSECTION_PARALLEL or
+//    INTERSECTION_COINCIDENT if not. (status & INTERSECTION_HIT) is the hit
+//    mask, so the array can be used as a compaction mask. The rules of
+//    parallel and coincident are same as Plane (see Intersection.h).
+// 3. intersectAll() finds the lines of all pairs (i < j) in the set. It walks
+//    the pairs tile by tile (L2-sized rows x L1-sized columns), and writes the
+//    intersected lines only with their plane indices (i, j).
+// 4. intersect(line) finds the parameter t of the intersection point p + tV
+//    of a line with all planes. A line out of [tMin, tMax] is returned as
+//    INTERSECTION_NONE in the status array.
+// 5. intersect(rhs1, rhs2) finds the points of i-th planes of 3 sets, and
+//    writes them as separate x[], y[], z[] arrays (aligned, same as the
+//    other SoA arrays). The status of a singular triple (no unique point) is
+//    INTERSECTION_PARALLEL.
+//
+// 6. The batch functions run on the threads of pool if it is given.
+//    intersectAll() gives each chunk of rows its own output, then joins them
+//    in row order. The set of lines is same as the single thread, but the
+//    order is different (it does not depend on the number of threads).
+//
+// Dependencies: Plane, LineBatch, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLANE_BATCH_H_DEF
+#define PLANE_BATCH_H_DEF
+
+#include <vector>
+#include "Simd.h"
+#include "Plane.h"
+#include "LineBatch.h"
+#include "ThreadPool.h"
+
+class PlaneBatch
+{
+public:
+    typedef std::vector<float, AlignedAllocator<float> > FloatArray;
+
+    // ctor/dtor
+    PlaneBatch() {}
+    PlaneBatch(const Plane* planes, int count);
+    ~PlaneBatch() {}
+
+    // size
+    int size() const                        { return (int)a.size(); }
+    void resize(int count);
+    void reserve(int count);
+    void clear();
+
+    // getters/setters
+    void add(const Plane& plane);
+    void add(float a, float b, float c, float d);
+    void set(int index, const Plane& plane);
+    void set(int index, float a, float b, float c, float d);
+    Plane get(int index) const;
+    const float* getA() const               { return a.data(); }
+    const float* getB() const               { return b.data(); }
+    const float* getC() const               { return c.data(); }
+    const float* getD() const               { return d.data(); }
+    float* getA()                           { return a.data(); }
+    float* getB()                           { return b.data(); }
+    float* getC()                           { return c.data(); }
+    float* getD()                           { return d.data(); }
+
+    // for intersection
+    // intersect i-th plane of this with i-th plane of rhs, return # of intersected pairs
+    int intersect(const PlaneBatch& rhs, LineBatch& lines, std::vector<unsigned char>& status,
+                  ThreadPool* pool=0) const;
+    // intersect i-th planes of this, rhs1 and rhs2, return # of intersected triples
+    int intersect(const PlaneBatch& rhs1, const PlaneBatch& rhs2,
+                  FloatArray& x, FloatArray& y, FloatArray& z,
+                  std::vector<unsigned char>& status, ThreadPool* pool=0) const;
+    // intersect all pairs (i < j) of this set, only non-parallel pairs are appended
+    int intersectAll(LineBatch& lines, std::vector<int>& indices1, std::vector<int>& indices2,
+                     ThreadPool* pool=0) const;
+    // intersect a line with all planes, return # of hits
+    int intersect(const Line& line, std::vector<float>& t, std::vector<unsigned char>& status,
+                  float tMin=-INFINITY, float tMax=INFINITY, ThreadPool* pool=0) const;
+
+protected:
+
+private:
+    int intersectRows(int rowFirst, int rowLast, LineBatch& lines,
+                      std::vector<int>& indices1, std::vector<int>& indices2) const;
+
+    FloatArray a, b, c;         // normal vectors
+    FloatArray d;               // constant terms
+};
+
+#endif
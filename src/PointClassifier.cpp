@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////
+// PointClassifier.cpp
+// ===================
+// classify a large set of points against a plane in a single streaming pass
+// The plane equation is normalized once at construction, so the signed
+// distance of a point is D = a'*x + b'*y + c'*z + d' (no division per point).
+//
+// Dependencies: Plane, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PointClassifier.h"
+
+
+
+// constants //////////////////////////////////////////////////////////////////
+// spread 4 bits to the even bits of a byte: 0bDCBA -> 0b0D0C0B0A
+const unsigned char SPREAD_BITS[16] = { 0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15,
+                                        0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55 };
+
+// the chunks of classify() on multiple threads must start at a code byte
+const int CODE_ALIGNMENT = (SIMD_WIDTH > 4) ? SIMD_WIDTH : 4;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+PointClassifier::PointClassifier(const Plane& plane, float tolerance) : pool(0)
+{
+    set(plane, tolerance);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// normalize the plane equation once, so no division is needed per point
+///////////////////////////////////////////////////////////////////////////////
+void PointClassifier::set(const Plane& plane, float tolerance)
+{
+    const Vector3& n = plane.getNormal();
+    float lengthInv = 1.0f / plane.getNormalLength();
+    a = n.x * lengthInv;
+    b = n.y * lengthInv;
+    c = n.z * lengthInv;
+    d = plane.getD() * lengthInv;
+    this->tolerance = tolerance;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute signed distances of interleaved points, (x,y,z) followed by
+// (stride - 3) other floats
+///////////////////////////////////////////////////////////////////////////////
+void PointClassifier::getDistances(const float* points, int count, float* distances, int stride) const
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            SimdFloat x, y, z;
+            int n = last - i;
+            loadPoints(points + i * stride, n, stride, x, y, z);
+            simdStoreN(distances + i, getDistance(x, y, z), n);
+        }
+    }, SIMD_WIDTH);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute signed distances of points in separate x[], y[], z[] arrays
+///////////////////////////////////////////////////////////////////////////////
+void PointClassifier::getDistances(const float* x, const float* y, const float* z,
+                                   int count, float* distances) const
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat dist = getDistance(simdLoadN(x + i, n), simdLoadN(y + i, n), simdLoadN(z + i, n));
+            simdStoreN(distances + i, dist, n);
+        }
+    }, SIMD_WIDTH);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write 2-bit codes of interleaved points
+///////////////////////////////////////////////////////////////////////////////
+void PointClassifier::classify(const float* points, int count, unsigned char* codes, int stride) const
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            SimdFloat x, y, z;
+            int n = last - i;
+            loadPoints(points + i * stride, n, stride, x, y, z);
+            storeCodes(codes, i, getDistance(x, y, z), n);
+        }
+    }, CODE_ALIGNMENT);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write 2-bit codes of points in separate x[], y[], z[] arrays
+///////////////////////////////////////////////////////////////////////////////
+void PointClassifier::classify(const float* x, const float* y, const float* z,
+                               int count, unsigned char* codes) const
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat dist = getDistance(simdLoadN(x + i, n), simdLoadN(y + i, n), simdLoadN(z + i, n));
+            storeCodes(codes, i, dist, n);
+        }
+    }, CODE_ALIGNMENT);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// load SIMD_WIDTH interleaved points into x, y, z vectors
+// packed (x,y,z) points use shuffles, others are gathered one by one
+///////////////////////////////////////////////////////////////////////////////
+void PointClassifier::loadPoints(const float* points, int count, int stride,
+                                 SimdFloat& x, SimdFloat& y, SimdFloat& z) const
+{
+    if(stride == 3)
+    {
+        simdLoadXyzN(points, count, x, y, z);
+        return;
+    }
+
+    float tx[SIMD_WIDTH] = {0}, ty[SIMD_WIDTH] = {0}, tz[SIMD_WIDTH] = {0};
+    for(int i = 0; i < count && i < SIMD_WIDTH; ++i, points += stride)
+    {
+        tx[i] = points[0];
+        ty[i] = points[1];
+        tz[i] = points[2];
+    }
+    x = simdLoad(tx);
+    y = simdLoad(ty);
+    z = simdLoad(tz);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// D = a'*x + b'*y + c'*z + d'
+///////////////////////////////////////////////////////////////////////////////
+inline SimdFloat PointClassifier::getDistance(SimdFloat x, SimdFloat y, SimdFloat z) const
+{
+    return simdMulAdd(simdSet(a), x, simdMulAdd(simdSet(b), y, simdMulAdd(simdSet(c), z, simdSet(d))));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// pack the codes of count (<= SIMD_WIDTH) lanes starting from index-th point
+// index is always a multiple of SIMD_WIDTH
+///////////////////////////////////////////////////////////////////////////////
+void PointClassifier::storeCodes(unsigned char* codes, int index, SimdFloat distance, int count) const
+{
+    if(count > SIMD_WIDTH)
+        count = SIMD_WIDTH;
+
+    int front = simdMoveMask(simdCmpGt(distance, simdSet(tolerance)));
+    int back  = simdMoveMask(simdCmpLt(distance, simdSet(-tolerance)));
+    if(count < SIMD_WIDTH)
+    {
+        // clear padded lanes
+        front &= (1 << count) - 1;
+        back  &= (1 << count) - 1;
+    }
+
+#if SIMD_WIDTH >= 4
+    // 4 lanes per byte
+    for(int i = 0; i < count; i += 4, front >>= 4, back >>= 4)
+        codes[(index + i) >> 2] = SPREAD_BITS[front & 15] | (SPREAD_BITS[back & 15] << 1);
+#else
+    // a lane at a time
+    int shift = (index & 3) * 2;
+    if(shift == 0)
+        codes[index >> 2] = 0;
+    codes[index >> 2] |= (unsigned char)((front | (back << 1)) << shift);
+#endif
+}
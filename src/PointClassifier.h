@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+// PointClassifier.h
+// =================
+// classify a large set of points against a plane in a single streaming pass
+// The plane equation is normalized once at construction, so the signed
+// distance of a point is D = a'*x + b'*y + c'*z + d' (no division per point).
+//
+// NOTE:
+// 1. The points can be interleaved (x,y,z,...) with a stride of floats, or
+//    stored in separate x[], y[], z[] arrays (SoA).
+// 2. classify() writes a 2-bit code per point, 4 points per byte; the code of
+//    the k-th point is (codes[k/4] >> (2 * (k%4))) & 3, and codes must have
+//    (count + 3) / 4 bytes.
+//    ON   : |D| <= tolerance
+//    FRONT: D > tolerance  (same side as the normal vector)
+//    BACK : D < -tolerance
+//
+// 3. If a thread pool is set, the points are split into chunks and processed
+//    on the threads of the pool.
+//
+// Dependencies: Plane, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef POINT_CLASSIFIER_H_DEF
+#define POINT_CLASSIFIER_H_DEF
+
+#include "Simd.h"
+#include "Plane.h"
+#include "ThreadPool.h"
+
+class PointClassifier
+{
+public:
+    // 2-bit codes of classify()
+    enum { ON = 0, FRONT = 1, BACK = 2 };
+
+    // ctor/dtor
+    PointClassifier(const Plane& plane, float tolerance=0);
+    ~PointClassifier() {}
+
+    // setters/getters
+    void set(const Plane& plane, float tolerance=0);
+    void setTolerance(float tolerance)  { this->tolerance = tolerance; }
+    float getTolerance() const          { return tolerance; }
+    void setThreadPool(ThreadPool* pool){ this->pool = pool; }   // NULL to run on this thread
+    ThreadPool* getThreadPool() const   { return pool; }
+
+    // signed distances from the plane
+    void getDistances(const float* points, int count, float* distances, int stride=3) const;
+    void getDistances(const float* x, const float* y, const float* z, int count, float* distances) const;
+
+    // 2-bit ON/FRONT/BACK codes
+    void classify(const float* points, int count, unsigned char* codes, int stride=3) const;
+    void classify(const float* x, const float* y, const float* z, int count, unsigned char* codes) const;
+
+protected:
+
+private:
+    void loadPoints(const float* points, int count, int stride,
+                    SimdFloat& x, SimdFloat& y, SimdFloat& z) const;
+    SimdFloat getDistance(SimdFloat x, SimdFloat y, SimdFloat z) const;
+    void storeCodes(unsigned char* codes, int index, SimdFloat distance, int count) const;
+
+    float a, b, c, d;       // normalized plane equation
+    float tolerance;        // max distance to be ON the plane
+    ThreadPool* pool;       // optional, not owned
+};
+
+#endif
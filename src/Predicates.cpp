@@ -0,0 +1,276 @@
+///////////////////////////////////////////////////////////////////////////////
+// Predicates.cpp
+// ==============
+// robust sign tests for parallel/coplanar detection
+// The floating-point value is used if it is outside of the rounding error
+// bound, otherwise the value is recomputed exactly with expansion arithmetic.
+//
+// Dependencies: Vector3
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <vector>
+#include "Predicates.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// counters per thread, so a call does not write a shared cache line
+// Only the owner thread increments them (a plain load and store, no atomic
+// read-modify-write), and getPredicateStats() sums all threads. The counters
+// of a finished thread are added to retiredStats.
+///////////////////////////////////////////////////////////////////////////////
+struct PredicateCounters
+{
+    std::atomic<unsigned long long> callCount;
+    std::atomic<unsigned long long> exactCount;
+
+    PredicateCounters();
+    ~PredicateCounters();
+};
+
+static std::mutex& counterMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::vector<PredicateCounters*>& counterList()
+{
+    static std::vector<PredicateCounters*> list;
+    return list;
+}
+
+static PredicateStats retiredStats = { 0, 0 };
+
+PredicateCounters::PredicateCounters() : callCount(0), exactCount(0)
+{
+    std::lock_guard<std::mutex> lock(counterMutex());
+    counterList().push_back(this);
+}
+
+PredicateCounters::~PredicateCounters()
+{
+    std::lock_guard<std::mutex> lock(counterMutex());
+    retiredStats.callCount += callCount.load(std::memory_order_relaxed);
+    retiredStats.exactCount += exactCount.load(std::memory_order_relaxed);
+    std::vector<PredicateCounters*>& list = counterList();
+    for(size_t i = 0; i < list.size(); ++i)
+    {
+        if(list[i] == this)
+        {
+            list.erase(list.begin() + i);
+            break;
+        }
+    }
+}
+
+static thread_local PredicateCounters counters;
+
+static inline void increment(std::atomic<unsigned long long>& count)
+{
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// error-free transformations
+// x + y = a * b exactly, where x = fl(a*b) and y is the rounding error
+// x + y = a + b exactly, where x = fl(a+b) and y is the rounding error
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+static inline void twoProduct(T a, T b, T& x, T& y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+template<typename T>
+static inline void twoSum(T a, T b, T& x, T& y)
+{
+    x = a + b;
+    T bv = x - a;
+    T av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a scalar to an expansion e[0..n) (increasing magnitude order), and store
+// the n+1 components to h. Return the number of components of h.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+static int growExpansion(const T* e, int n, T b, T* h)
+{
+    T q = b;
+    for(int i = 0; i < n; ++i)
+        twoSum(q, e[i], q, h[i]);
+    h[n] = q;
+    return n + 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// the sign of an expansion is the sign of its largest non-zero component
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+static int expansionSign(const T* e, int n)
+{
+    for(int i = n - 1; i >= 0; --i)
+    {
+        if(e[i] > 0)
+            return 1;
+        else if(e[i] < 0)
+            return -1;
+    }
+    return 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// rounding error bound factors, u = half of machine epsilon
+// |fl(ab - cd) - (ab - cd)| <= (3u + 16u^2) * (|ab| + |cd|)
+// |fl(ab + cd + ef) - (ab + cd + ef)| <= (4u + 32u^2) * (|ab| + |cd| + |ef|)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+static inline T det2ErrorFactor()
+{
+    const T u = std::numeric_limits<T>::epsilon() / 2;
+    return (3 + 16 * u) * u;
+}
+
+template<typename T>
+static inline T dotErrorFactor()
+{
+    const T u = std::numeric_limits<T>::epsilon() / 2;
+    return (4 + 32 * u) * u;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sign of (a*d - b*c)
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int det2Sign(T a, T b, T c, T d)
+{
+    increment(counters.callCount);
+
+    // fast path
+    T ad = a * d;
+    T bc = b * c;
+    T det = ad - bc;
+    T bound = det2ErrorFactor<T>() * (std::fabs(ad) + std::fabs(bc));
+    if(det > bound)
+        return 1;
+    else if(det < -bound)
+        return -1;
+
+    // exact path: ad - bc as an expansion of 4 components
+    increment(counters.exactCount);
+    T e[4], h[4], x, y;
+    twoProduct(a, d, e[1], e[0]);
+    twoProduct(b, c, x, y);
+    int n = growExpansion(e, 2, -y, h);
+    n = growExpansion(h, n, -x, e);
+    return expansionSign(e, n);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sign of u.v
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+int dotSign(const Vector3T<T>& u, const Vector3T<T>& v)
+{
+    increment(counters.callCount);
+
+    // fast path
+    T xx = u.x * v.x;
+    T yy = u.y * v.y;
+    T zz = u.z * v.z;
+    T dot = xx + yy + zz;
+    T bound = dotErrorFactor<T>() * (std::fabs(xx) + std::fabs(yy) + std::fabs(zz));
+    if(dot > bound)
+        return 1;
+    else if(dot < -bound)
+        return -1;
+
+    // exact path: the sum of 3 products as an expansion of 6 components
+    increment(counters.exactCount);
+    T e[6], h[6], x, y;
+    twoProduct(u.x, v.x, e[1], e[0]);
+    twoProduct(u.y, v.y, x, y);
+    int n = growExpansion(e, 2, y, h);
+    n = growExpansion(h, n, x, e);
+    twoProduct(u.z, v.z, x, y);
+    n = growExpansion(e, n, y, h);
+    n = growExpansion(h, n, x, e);
+    return expansionSign(e, n);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// u x v = 0 if all 3 components are exactly 0
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+bool isParallel(const Vector3T<T>& u, const Vector3T<T>& v)
+{
+    return det2Sign(u.y, u.z, v.y, v.z) == 0 &&
+           det2Sign(u.z, u.x, v.z, v.x) == 0 &&
+           det2Sign(u.x, u.y, v.x, v.y) == 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// counters
+///////////////////////////////////////////////////////////////////////////////
+PredicateStats getPredicateStats()
+{
+    std::lock_guard<std::mutex> lock(counterMutex());
+    PredicateStats stats = retiredStats;
+    const std::vector<PredicateCounters*>& list = counterList();
+    for(size_t i = 0; i < list.size(); ++i)
+    {
+        stats.callCount += list[i]->callCount.load(std::memory_order_relaxed);
+        stats.exactCount += list[i]->exactCount.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void resetPredicateStats()
+{
+    std::lock_guard<std::mutex> lock(counterMutex());
+    retiredStats.callCount = retiredStats.exactCount = 0;
+    const std::vector<PredicateCounters*>& list = counterList();
+    for(size_t i = 0; i < list.size(); ++i)
+    {
+        list[i]->callCount.store(0, std::memory_order_relaxed);
+        list[i]->exactCount.store(0, std::memory_order_relaxed);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// instantiate float and double versions
+///////////////////////////////////////////////////////////////////////////////
+template int det2Sign<float>(float, float, float, float);
+template int det2Sign<double>(double, double, double, double);
+template int dotSign<float>(const Vector3T<float>&, const Vector3T<float>&);
+template int dotSign<double>(const Vector3T<double>&, const Vector3T<double>&);
+template bool isParallel<float>(const Vector3T<float>&, const Vector3T<float>&);
+template bool isParallel<double>(const Vector3T<double>&, const Vector3T<double>&);
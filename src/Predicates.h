@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+// Predicates.h
+// ============
+// robust sign tests for parallel/coplanar detection
+// Each predicate computes the value in floating point first, and returns its
+// sign if the value is larger than the rounding error bound. Only if it is in
+// the uncertain band, the value is recomputed exactly with expansion
+// arithmetic (a sum of non-overlapping floats, see Shewchuk's "Adaptive
+// Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates").
+//
+// NOTE:
+// 1. The functions are templates of float and double, and both are
+//    instantiated in Predicates.cpp.
+// 2. getPredicateStats() returns how many times the predicates are called and
+//    how many of them fell back to the exact (slow) path. isParallel() counts
+//    a call per component of the cross product. The counters are per thread
+//    and summed when read, so counting does not share a cache line between
+//    threads. resetPredicateStats() while other threads are calling the
+//    predicates may miss their increments in flight.
+// 3. The exact path assumes the products do not underflow or overflow.
+//
+// Dependencies: Vector3
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PREDICATES_H_DEF
+#define PREDICATES_H_DEF
+
+#include "Vectors.h"
+
+// counters of predicates
+struct PredicateStats
+{
+    unsigned long long callCount;   // # of calls
+    unsigned long long exactCount;  // # of calls took the exact path
+};
+
+// sign of (a*d - b*c), -1, 0 or 1
+template<typename T>
+int det2Sign(T a, T b, T c, T d);
+
+// sign of dot product u.v
+template<typename T>
+int dotSign(const Vector3T<T>& u, const Vector3T<T>& v);
+
+// true if u x v is exactly 0 (same or opposite direction, or a zero vector)
+template<typename T>
+bool isParallel(const Vector3T<T>& u, const Vector3T<T>& v);
+
+// counters
+PredicateStats getPredicateStats();
+void resetPredicateStats();
+
+#endif
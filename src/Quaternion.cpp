@@ -0,0 +1,248 @@
+///////////////////////////////////////////////////////////////////////////////
+// Quaternion.cpp
+// ==============
+// Quaternion class to represent 3D rotation, q = s + xi + yj + zk
+//
+// Dependencies: Vector3, Matrix3, Matrix4, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Quaternion.h"
+#include "Simd.h"
+
+// compose() loads a quaternion as 4 floats
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be 4 floats");
+
+const float SLERP_EPSILON = 0.0005f;    // use normalized lerp if the angle is smaller
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build quaternion from the 3x3 rotation part of column major matrix
+// m0, m1, m2 are the 1st column, m3, m4, m5 the 2nd, and m6, m7, m8 the 3rd.
+// It divides by the largest of 4|s|, 4|x|, 4|y|, 4|z| for precision.
+///////////////////////////////////////////////////////////////////////////////
+static Quaternion fromRotation(float m0, float m1, float m2,
+                               float m3, float m4, float m5,
+                               float m6, float m7, float m8)
+{
+    float trace = m0 + m4 + m8;
+    if(trace > 0)
+    {
+        float s4 = sqrtf(trace + 1.0f) * 2.0f;             // 4s
+        return Quaternion(0.25f * s4, (m5 - m7) / s4, (m6 - m2) / s4, (m1 - m3) / s4);
+    }
+    else if(m0 > m4 && m0 > m8)
+    {
+        float x4 = sqrtf(1.0f + m0 - m4 - m8) * 2.0f;      // 4x
+        return Quaternion((m5 - m7) / x4, 0.25f * x4, (m1 + m3) / x4, (m2 + m6) / x4);
+    }
+    else if(m4 > m8)
+    {
+        float y4 = sqrtf(1.0f + m4 - m0 - m8) * 2.0f;      // 4y
+        return Quaternion((m6 - m2) / y4, (m1 + m3) / y4, 0.25f * y4, (m5 + m7) / y4);
+    }
+    else
+    {
+        float z4 = sqrtf(1.0f + m8 - m0 - m4) * 2.0f;      // 4z
+        return Quaternion((m1 - m3) / z4, (m2 + m6) / z4, (m5 + m7) / z4, 0.25f * z4);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctors
+///////////////////////////////////////////////////////////////////////////////
+Quaternion::Quaternion(const Vector3& axis, float angle)
+{
+    set(axis, angle);
+}
+
+Quaternion::Quaternion(const Matrix3& m)
+{
+    *this = fromRotation(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]);
+}
+
+Quaternion::Quaternion(const Matrix4& m)
+{
+    *this = fromRotation(m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set quaternion from axis and angle (degree), the axis does not need to be
+// unit length. q = cos(a/2) + sin(a/2) * axis
+///////////////////////////////////////////////////////////////////////////////
+void Quaternion::set(const Vector3& axis, float angle)
+{
+    Vector3 v = axis;
+    v.normalize();
+
+    float halfAngle = 0.5f * angle * DEG2RAD;
+    float sine = sinf(halfAngle);
+    s = cosf(halfAngle);
+    x = v.x * sine;
+    y = v.y * sine;
+    z = v.z * sine;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// normalize to unit quaternion, keep zero quaternion as is
+///////////////////////////////////////////////////////////////////////////////
+Quaternion& Quaternion::normalize()
+{
+    float lengthSq = s*s + x*x + y*y + z*z;
+    if(lengthSq > 0)
+    {
+        float invLength = 1.0f / sqrtf(lengthSq);
+        s *= invLength;  x *= invLength;  y *= invLength;  z *= invLength;
+    }
+    return *this;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// q^-1 = conjugate(q) / |q|^2
+///////////////////////////////////////////////////////////////////////////////
+Quaternion& Quaternion::invert()
+{
+    float lengthSq = s*s + x*x + y*y + z*z;
+    if(lengthSq > 0)
+    {
+        float invLengthSq = 1.0f / lengthSq;
+        s *= invLengthSq;  x *= -invLengthSq;  y *= -invLengthSq;  z *= -invLengthSq;
+    }
+    return *this;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return 3x3 rotation matrix of unit quaternion
+// | 1-2(yy+zz)   2(xy-sz)   2(xz+sy) |
+// |   2(xy+sz) 1-2(xx+zz)   2(yz-sx) |
+// |   2(xz-sy)   2(yz+sx) 1-2(xx+yy) |
+///////////////////////////////////////////////////////////////////////////////
+Matrix3 Quaternion::getMatrix3() const
+{
+    float x2 = x + x, y2 = y + y, z2 = z + z;
+    float xx = x * x2, xy = x * y2, xz = x * z2;
+    float yy = y * y2, yz = y * z2, zz = z * z2;
+    float sx = s * x2, sy = s * y2, sz = s * z2;
+
+    return Matrix3(1 - (yy + zz), xy + sz,       xz - sy,           // 1st column
+                   xy - sz,       1 - (xx + zz), yz + sx,           // 2nd column
+                   xz + sy,       yz - sx,       1 - (xx + yy));    // 3rd column
+}
+
+Matrix4 Quaternion::getMatrix() const
+{
+    float x2 = x + x, y2 = y + y, z2 = z + z;
+    float xx = x * x2, xy = x * y2, xz = x * z2;
+    float yy = y * y2, yz = y * z2, zz = z * z2;
+    float sx = s * x2, sy = s * y2, sz = s * z2;
+
+    return Matrix4(1 - (yy + zz), xy + sz,       xz - sy,       0,  // 1st column
+                   xy - sz,       1 - (xx + zz), yz + sx,       0,  // 2nd column
+                   xz + sy,       yz - sx,       1 - (xx + yy), 0,  // 3rd column
+                   0,             0,             0,             1); // 4th column
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// rotate vector with unit quaternion, v' = q * v * q^-1
+// t = 2(u x v), v' = v + s*t + u x t  (u is the vector part of q)
+///////////////////////////////////////////////////////////////////////////////
+Vector3 Quaternion::rotate(const Vector3& v) const
+{
+    float tx = 2.0f * (y * v.z - z * v.y);
+    float ty = 2.0f * (z * v.x - x * v.z);
+    float tz = 2.0f * (x * v.y - y * v.x);
+    return Vector3(v.x + s * tx + (y * tz - z * ty),
+                   v.y + s * ty + (z * tx - x * tz),
+                   v.z + s * tz + (x * ty - y * tx));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// spherical linear interpolation of unit quaternions
+// q(t) = (sin((1-t)a) * from + sin(ta) * to) / sin(a), cos(a) = from.to
+// It flips "to" if the dot product is negative to take the shortest arc, and
+// falls back to normalized lerp for a small angle (sin(a) ~ 0).
+///////////////////////////////////////////////////////////////////////////////
+Quaternion Quaternion::slerp(const Quaternion& from, const Quaternion& to, float t)
+{
+    float cosine = from.dot(to);
+    Quaternion q = to;
+    if(cosine < 0)
+    {
+        cosine = -cosine;
+        q = -to;
+    }
+
+    float t1, t2;
+    if(cosine > 1.0f - SLERP_EPSILON)
+    {
+        t1 = 1.0f - t;
+        t2 = t;
+    }
+    else
+    {
+        float angle = acosf(cosine);
+        float invSine = 1.0f / sinf(angle);
+        t1 = sinf((1.0f - t) * angle) * invSine;
+        t2 = sinf(t * angle) * invSine;
+    }
+
+    Quaternion result = from * t1 + q * t2;
+    return result.normalize();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dst[i] = lhs[i] * rhs[i]
+// With SSE, 4 quaternions are transposed to s, x, y, z vectors, so the
+// product is 16 multiply-adds for 4 pairs.
+///////////////////////////////////////////////////////////////////////////////
+void Quaternion::compose(const Quaternion* lhs, const Quaternion* rhs, Quaternion* dst, int count,
+                         ThreadPool* pool)
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        int i = first;
+#if defined(SIMD4)
+        for(; i + 4 <= last; i += 4)
+        {
+            Simd4 s1 = simd4Load(&lhs[i].s),   x1 = simd4Load(&lhs[i+1].s);
+            Simd4 y1 = simd4Load(&lhs[i+2].s), z1 = simd4Load(&lhs[i+3].s);
+            Simd4 s2 = simd4Load(&rhs[i].s),   x2 = simd4Load(&rhs[i+1].s);
+            Simd4 y2 = simd4Load(&rhs[i+2].s), z2 = simd4Load(&rhs[i+3].s);
+            simd4Transpose(s1, x1, y1, z1);
+            simd4Transpose(s2, x2, y2, z2);
+
+            Simd4 s = simd4Sub(simd4Mul(s1, s2), simd4MulAdd(x1, x2, simd4MulAdd(y1, y2, simd4Mul(z1, z2))));
+            Simd4 x = simd4Sub(simd4MulAdd(s1, x2, simd4MulAdd(x1, s2, simd4Mul(y1, z2))), simd4Mul(z1, y2));
+            Simd4 y = simd4Sub(simd4MulAdd(s1, y2, simd4MulAdd(y1, s2, simd4Mul(z1, x2))), simd4Mul(x1, z2));
+            Simd4 z = simd4Sub(simd4MulAdd(s1, z2, simd4MulAdd(x1, y2, simd4Mul(z1, s2))), simd4Mul(y1, x2));
+
+            simd4Transpose(s, x, y, z);
+            simd4Store(&dst[i].s, s);
+            simd4Store(&dst[i+1].s, x);
+            simd4Store(&dst[i+2].s, y);
+            simd4Store(&dst[i+3].s, z);
+        }
+#endif
+        for(; i < last; ++i)
+            dst[i] = lhs[i] * rhs[i];
+    }, 4);
+}
@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// Quaternion.h
+// ============
+// Quaternion class to represent 3D rotation, q = s + xi + yj + zk
+// The composition of 2 rotations is a quaternion product (16 multiplies)
+// instead of a matrix product, and it converts to Matrix3/Matrix4 once
+// before drawing.
+//
+// NOTE:
+// 1. The angle of the axis-angle ctor is in degree, same as Matrix4::rotate().
+// 2. q1 * q2 rotates by q2 first, then q1, same as M1 * M2 of Matrix4.
+// 3. The rotation functions assume a unit quaternion. Call normalize() after
+//    many incremental compositions to remove the accumulated error.
+// 4. The ctors from Matrix3/Matrix4 use the 3x3 part without scale.
+// 5. compose() multiplies arrays of quaternions, 4 pairs at once with SSE,
+//    and runs on the threads of pool if it is given.
+//
+// Dependencies: Vector3, Matrix3, Matrix4, Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef QUATERNION_H_DEF
+#define QUATERNION_H_DEF
+
+#include <cmath>
+#include <iostream>
+#include "Vectors.h"
+#include "Matrices.h"
+#include "ThreadPool.h"
+
+struct Quaternion
+{
+    float s;    // scalar part, cos(angle/2)
+    float x;    // vector part, axis * sin(angle/2)
+    float y;
+    float z;
+
+    // ctors
+    Quaternion() : s(1), x(0), y(0), z(0) {}                // identity
+    Quaternion(float s, float x, float y, float z) : s(s), x(x), y(y), z(z) {}
+    Quaternion(const Vector3& axis, float angle);           // rotate angle(degree) along axis
+    explicit Quaternion(const Matrix3& m);                  // rotation matrix to quaternion
+    explicit Quaternion(const Matrix4& m);                  // 3x3 part of m
+
+    // utils
+    void        set(float s, float x, float y, float z);
+    void        set(const Vector3& axis, float angle);      // angle in degree
+    float       length() const;
+    float       dot(const Quaternion& rhs) const;
+    Quaternion& normalize();
+    Quaternion& conjugate();                                // inverse of unit quaternion
+    Quaternion& invert();                                   // inverse of any quaternion
+    Quaternion& identity();
+
+    Matrix3     getMatrix3() const;                         // rotation matrix
+    Matrix4     getMatrix() const;                          // rotation matrix with no translation
+    Vector3     rotate(const Vector3& v) const;             // v' = q * v * q^-1
+
+    // interpolation by t in [0, 1] along the shortest arc
+    static Quaternion slerp(const Quaternion& from, const Quaternion& to, float t);
+
+    // batch, dst[i] = lhs[i] * rhs[i], dst can be lhs or rhs
+    static void compose(const Quaternion* lhs, const Quaternion* rhs, Quaternion* dst, int count,
+                        ThreadPool* pool=0);
+
+    // operators
+    Quaternion  operator-() const;                          // unary operator (negate)
+    Quaternion  operator+(const Quaternion& rhs) const;
+    Quaternion  operator-(const Quaternion& rhs) const;
+    Quaternion  operator*(float a) const;
+    Quaternion  operator*(const Quaternion& rhs) const;     // rotate by rhs, then this
+    Quaternion& operator*=(const Quaternion& rhs);
+    Vector3     operator*(const Vector3& v) const;          // same as rotate(v)
+    bool        operator==(const Quaternion& rhs) const;
+    bool        operator!=(const Quaternion& rhs) const;
+
+    friend Quaternion operator*(float a, const Quaternion& q);
+    friend std::ostream& operator<<(std::ostream& os, const Quaternion& q);
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inline functions for Quaternion
+///////////////////////////////////////////////////////////////////////////////
+inline void Quaternion::set(float s, float x, float y, float z)
+{
+    this->s = s;  this->x = x;  this->y = y;  this->z = z;
+}
+
+inline float Quaternion::length() const
+{
+    return sqrtf(s*s + x*x + y*y + z*z);
+}
+
+inline float Quaternion::dot(const Quaternion& rhs) const
+{
+    return s*rhs.s + x*rhs.x + y*rhs.y + z*rhs.z;
+}
+
+inline Quaternion& Quaternion::conjugate()
+{
+    x = -x;  y = -y;  z = -z;
+    return *this;
+}
+
+inline Quaternion& Quaternion::identity()
+{
+    s = 1;  x = y = z = 0;
+    return *this;
+}
+
+inline Quaternion Quaternion::operator-() const
+{
+    return Quaternion(-s, -x, -y, -z);
+}
+
+inline Quaternion Quaternion::operator+(const Quaternion& rhs) const
+{
+    return Quaternion(s + rhs.s, x + rhs.x, y + rhs.y, z + rhs.z);
+}
+
+inline Quaternion Quaternion::operator-(const Quaternion& rhs) const
+{
+    return Quaternion(s - rhs.s, x - rhs.x, y - rhs.y, z - rhs.z);
+}
+
+inline Quaternion Quaternion::operator*(float a) const
+{
+    return Quaternion(s * a, x * a, y * a, z * a);
+}
+
+// (s1, v1) * (s2, v2) = (s1s2 - v1.v2, s1v2 + s2v1 + v1 x v2)
+inline Quaternion Quaternion::operator*(const Quaternion& rhs) const
+{
+    return Quaternion(s*rhs.s - x*rhs.x - y*rhs.y - z*rhs.z,
+                      s*rhs.x + x*rhs.s + y*rhs.z - z*rhs.y,
+                      s*rhs.y - x*rhs.z + y*rhs.s + z*rhs.x,
+                      s*rhs.z + x*rhs.y - y*rhs.x + z*rhs.s);
+}
+
+inline Quaternion& Quaternion::operator*=(const Quaternion& rhs)
+{
+    *this = *this * rhs;
+    return *this;
+}
+
+inline Vector3 Quaternion::operator*(const Vector3& v) const
+{
+    return rotate(v);
+}
+
+inline bool Quaternion::operator==(const Quaternion& rhs) const
+{
+    return (s == rhs.s) && (x == rhs.x) && (y == rhs.y) && (z == rhs.z);
+}
+
+inline bool Quaternion::operator!=(const Quaternion& rhs) const
+{
+    return !(*this == rhs);
+}
+
+inline Quaternion operator*(float a, const Quaternion& q)
+{
+    return Quaternion(a * q.s, a * q.x, a * q.y, a * q.z);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Quaternion& q)
+{
+    os << "(" << q.s << ", " << q.x << ", " << q.y << ", " << q.z << ")";
+    return os;
+}
+// END OF QUATERNION //////////////////////////////////////////////////////////
+
+#endif
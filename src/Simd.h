@@ -0,0 +1,411 @@
+///////////////////////////////////////////////////////////////////////////////
+// Simd.h
+// ======
+// thin wrappers of SSE/AVX intrinsics for the batch (SoA) kernels
+//
+// The width is selected at build time:
+//   -mavx (or /arch:AVX)  : 8 lanes, __m256
+//   SSE2 (any x86-64)     : 4 lanes, __m128
+//   otherwise             : 1 lane, plain float
+// Add -mfma to use fused multiply-add in simdMulAdd().
+// Simd4 is a 4-lane vector on SSE and AVX builds for Vector4 and Matrix4.
+//
+// A comparison returns a lane mask (all bits set or cleared per lane), which
+// can be combined with simdAnd/simdOr/simdSelect, or packed into an integer
+// with simdMoveMask() (bit k is set if lane k is true).
+//
+// simdLoadN()/simdStoreN() handle the last partial vector of an array, so the
+// kernels do not need a separate scalar tail loop. simdLoadXyzN() and
+// simdStoreXyzN() do the same for interleaved (x,y,z,x,y,z,...) arrays.
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SIMD_H_DEF
+#define SIMD_H_DEF
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SIMD_WIDTH  8
+#define SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#if defined(__FMA__)
+#include <immintrin.h>
+#endif
+#define SIMD_WIDTH  4
+#define SIMD_SSE
+#else
+#define SIMD_WIDTH  1
+#endif
+
+#define SIMD_ALIGNMENT  32          // byte alignment of batch arrays (AVX register)
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// allocator for std::vector to align the first element at given bytes
+///////////////////////////////////////////////////////////////////////////////
+template<typename T, std::size_t Alignment = SIMD_ALIGNMENT>
+struct AlignedAllocator
+{
+    typedef T value_type;
+    template<typename U> struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+    AlignedAllocator() {}
+    template<typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n)
+    {
+        // over-allocate, then store the original pointer right before the
+        // aligned block, so deallocate() can find it
+        void* raw = std::malloc(n * sizeof(T) + Alignment + sizeof(void*));
+        if(!raw)
+            throw std::bad_alloc();
+        std::size_t addr = ((std::size_t)raw + sizeof(void*) + Alignment - 1) & ~(Alignment - 1);
+        ((void**)addr)[-1] = raw;
+        return (T*)addr;
+    }
+
+    void deallocate(T* p, std::size_t)
+    {
+        if(p)
+            std::free(((void**)p)[-1]);
+    }
+};
+
+template<typename T, typename U, std::size_t A>
+inline bool operator==(const AlignedAllocator<T,A>&, const AlignedAllocator<U,A>&) { return true; }
+template<typename T, typename U, std::size_t A>
+inline bool operator!=(const AlignedAllocator<T,A>&, const AlignedAllocator<U,A>&) { return false; }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX: 8 lanes
+///////////////////////////////////////////////////////////////////////////////
+#if defined(SIMD_AVX)
+typedef __m256 SimdFloat;
+
+inline SimdFloat simdZero()                             { return _mm256_setzero_ps(); }
+inline SimdFloat simdSet(float a)                       { return _mm256_set1_ps(a); }
+inline SimdFloat simdLoad(const float* p)               { return _mm256_loadu_ps(p); }
+inline void      simdStore(float* p, SimdFloat a)       { _mm256_storeu_ps(p, a); }
+inline SimdFloat simdAdd(SimdFloat a, SimdFloat b)      { return _mm256_add_ps(a, b); }
+inline SimdFloat simdSub(SimdFloat a, SimdFloat b)      { return _mm256_sub_ps(a, b); }
+inline SimdFloat simdMul(SimdFloat a, SimdFloat b)      { return _mm256_mul_ps(a, b); }
+inline SimdFloat simdDiv(SimdFloat a, SimdFloat b)      { return _mm256_div_ps(a, b); }
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b)      { return _mm256_min_ps(a, b); }
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b)      { return _mm256_max_ps(a, b); }
+inline SimdFloat simdSqrt(SimdFloat a)                  { return _mm256_sqrt_ps(a); }
+inline SimdFloat simdRSqrt(SimdFloat a)                 { return _mm256_rsqrt_ps(a); }      // ~12 bits
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b)      { return _mm256_and_ps(a, b); }
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b)       { return _mm256_or_ps(a, b); }
+inline SimdFloat simdAndNot(SimdFloat a, SimdFloat b)   { return _mm256_andnot_ps(a, b); }  // ~a & b
+inline SimdFloat simdCmpEq(SimdFloat a, SimdFloat b)    { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+inline SimdFloat simdCmpNeq(SimdFloat a, SimdFloat b)   { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+inline SimdFloat simdCmpLt(SimdFloat a, SimdFloat b)    { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+inline SimdFloat simdCmpLe(SimdFloat a, SimdFloat b)    { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+inline SimdFloat simdCmpGt(SimdFloat a, SimdFloat b)    { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline SimdFloat simdCmpGe(SimdFloat a, SimdFloat b)    { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+inline SimdFloat simdSelect(SimdFloat m, SimdFloat a, SimdFloat b) { return _mm256_blendv_ps(b, a, m); } // m ? a : b
+inline int       simdMoveMask(SimdFloat m)              { return _mm256_movemask_ps(m); }
+#if defined(__FMA__)
+inline SimdFloat simdMulAdd(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm256_fmadd_ps(a, b, c); }
+inline SimdFloat simdMulSub(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm256_fmsub_ps(a, b, c); }
+#else
+inline SimdFloat simdMulAdd(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+inline SimdFloat simdMulSub(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm256_sub_ps(_mm256_mul_ps(a, b), c); }
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// SSE: 4 lanes
+///////////////////////////////////////////////////////////////////////////////
+#elif defined(SIMD_SSE)
+typedef __m128 SimdFloat;
+
+inline SimdFloat simdZero()                             { return _mm_setzero_ps(); }
+inline SimdFloat simdSet(float a)                       { return _mm_set1_ps(a); }
+inline SimdFloat simdLoad(const float* p)               { return _mm_loadu_ps(p); }
+inline void      simdStore(float* p, SimdFloat a)       { _mm_storeu_ps(p, a); }
+inline SimdFloat simdAdd(SimdFloat a, SimdFloat b)      { return _mm_add_ps(a, b); }
+inline SimdFloat simdSub(SimdFloat a, SimdFloat b)      { return _mm_sub_ps(a, b); }
+inline SimdFloat simdMul(SimdFloat a, SimdFloat b)      { return _mm_mul_ps(a, b); }
+inline SimdFloat simdDiv(SimdFloat a, SimdFloat b)      { return _mm_div_ps(a, b); }
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b)      { return _mm_min_ps(a, b); }
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b)      { return _mm_max_ps(a, b); }
+inline SimdFloat simdSqrt(SimdFloat a)                  { return _mm_sqrt_ps(a); }
+inline SimdFloat simdRSqrt(SimdFloat a)                 { return _mm_rsqrt_ps(a); }         // ~12 bits
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b)      { return _mm_and_ps(a, b); }
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b)       { return _mm_or_ps(a, b); }
+inline SimdFloat simdAndNot(SimdFloat a, SimdFloat b)   { return _mm_andnot_ps(a, b); }     // ~a & b
+inline SimdFloat simdCmpEq(SimdFloat a, SimdFloat b)    { return _mm_cmpeq_ps(a, b); }
+inline SimdFloat simdCmpNeq(SimdFloat a, SimdFloat b)   { return _mm_cmpneq_ps(a, b); }
+inline SimdFloat simdCmpLt(SimdFloat a, SimdFloat b)    { return _mm_cmplt_ps(a, b); }
+inline SimdFloat simdCmpLe(SimdFloat a, SimdFloat b)    { return _mm_cmple_ps(a, b); }
+inline SimdFloat simdCmpGt(SimdFloat a, SimdFloat b)    { return _mm_cmpgt_ps(a, b); }
+inline SimdFloat simdCmpGe(SimdFloat a, SimdFloat b)    { return _mm_cmpge_ps(a, b); }
+inline SimdFloat simdSelect(SimdFloat m, SimdFloat a, SimdFloat b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+inline int       simdMoveMask(SimdFloat m)              { return _mm_movemask_ps(m); }
+#if defined(__FMA__)
+inline SimdFloat simdMulAdd(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm_fmadd_ps(a, b, c); }
+inline SimdFloat simdMulSub(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm_fmsub_ps(a, b, c); }
+#else
+inline SimdFloat simdMulAdd(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+inline SimdFloat simdMulSub(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm_sub_ps(_mm_mul_ps(a, b), c); }
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// scalar fallback: 1 lane
+// masks are stored as all-one or all-zero bit patterns of a float
+///////////////////////////////////////////////////////////////////////////////
+#else
+typedef float SimdFloat;
+
+inline unsigned int simdBits(float a)                   { unsigned int i; std::memcpy(&i, &a, 4); return i; }
+inline float        simdFloat(unsigned int i)           { float a; std::memcpy(&a, &i, 4); return a; }
+inline float        simdMask(bool b)                    { return simdFloat(b ? 0xffffffffu : 0); }
+
+inline SimdFloat simdZero()                             { return 0.0f; }
+inline SimdFloat simdSet(float a)                       { return a; }
+inline SimdFloat simdLoad(const float* p)               { return *p; }
+inline void      simdStore(float* p, SimdFloat a)       { *p = a; }
+inline SimdFloat simdAdd(SimdFloat a, SimdFloat b)      { return a + b; }
+inline SimdFloat simdSub(SimdFloat a, SimdFloat b)      { return a - b; }
+inline SimdFloat simdMul(SimdFloat a, SimdFloat b)      { return a * b; }
+inline SimdFloat simdDiv(SimdFloat a, SimdFloat b)      { return a / b; }
+inline SimdFloat simdMin(SimdFloat a, SimdFloat b)      { return b < a ? b : a; }
+inline SimdFloat simdMax(SimdFloat a, SimdFloat b)      { return b > a ? b : a; }
+inline SimdFloat simdSqrt(SimdFloat a)                  { return sqrtf(a); }
+inline SimdFloat simdRSqrt(SimdFloat a)                 { return 1.0f / sqrtf(a); }
+inline SimdFloat simdAnd(SimdFloat a, SimdFloat b)      { return simdFloat(simdBits(a) & simdBits(b)); }
+inline SimdFloat simdOr(SimdFloat a, SimdFloat b)       { return simdFloat(simdBits(a) | simdBits(b)); }
+inline SimdFloat simdAndNot(SimdFloat a, SimdFloat b)   { return simdFloat(~simdBits(a) & simdBits(b)); }
+inline SimdFloat simdCmpEq(SimdFloat a, SimdFloat b)    { return simdMask(a == b); }
+inline SimdFloat simdCmpNeq(SimdFloat a, SimdFloat b)   { return simdMask(!(a == b)); }
+inline SimdFloat simdCmpLt(SimdFloat a, SimdFloat b)    { return simdMask(a < b); }
+inline SimdFloat simdCmpLe(SimdFloat a, SimdFloat b)    { return simdMask(a <= b); }
+inline SimdFloat simdCmpGt(SimdFloat a, SimdFloat b)    { return simdMask(a > b); }
+inline SimdFloat simdCmpGe(SimdFloat a, SimdFloat b)    { return simdMask(a >= b); }
+inline SimdFloat simdSelect(SimdFloat m, SimdFloat a, SimdFloat b) { return simdBits(m) ? a : b; }
+inline int       simdMoveMask(SimdFloat m)              { return simdBits(m) ? 1 : 0; }
+inline SimdFloat simdMulAdd(SimdFloat a, SimdFloat b, SimdFloat c) { return a * b + c; }
+inline SimdFloat simdMulSub(SimdFloat a, SimdFloat b, SimdFloat c) { return a * b - c; }
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 4 lanes for a single Vector4 or a column of Matrix4 (SSE and AVX builds)
+// SIMD4 is defined if available, otherwise the callers use plain float.
+///////////////////////////////////////////////////////////////////////////////
+#if defined(SIMD_AVX) || defined(SIMD_SSE)
+#define SIMD4
+typedef __m128 Simd4;
+
+inline Simd4 simd4Set(float a)                          { return _mm_set1_ps(a); }
+inline Simd4 simd4Load(const float* p)                  { return _mm_loadu_ps(p); }
+inline void  simd4Store(float* p, Simd4 a)              { _mm_storeu_ps(p, a); }
+inline Simd4 simd4Add(Simd4 a, Simd4 b)                 { return _mm_add_ps(a, b); }
+inline Simd4 simd4Sub(Simd4 a, Simd4 b)                 { return _mm_sub_ps(a, b); }
+inline Simd4 simd4Mul(Simd4 a, Simd4 b)                 { return _mm_mul_ps(a, b); }
+#if defined(__FMA__)
+inline Simd4 simd4MulAdd(Simd4 a, Simd4 b, Simd4 c)     { return _mm_fmadd_ps(a, b, c); }
+#else
+inline Simd4 simd4MulAdd(Simd4 a, Simd4 b, Simd4 c)     { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#endif
+inline void  simd4Transpose(Simd4& r0, Simd4& r1, Simd4& r2, Simd4& r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+// convert 4 interleaved points (12 floats) to x, y, z vectors with shuffles
+// v0 = (x0 y0 z0 x1), v1 = (y1 z1 x2 y2), v2 = (z2 x3 y3 z3)
+inline void simd4LoadXyz(const float* p, Simd4& x, Simd4& y, Simd4& z)
+{
+    __m128 v0 = _mm_loadu_ps(p);
+    __m128 v1 = _mm_loadu_ps(p + 4);
+    __m128 v2 = _mm_loadu_ps(p + 8);
+    __m128 t0 = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1,0,3,2));   // (x2 y2 z2 x3)
+    __m128 t1 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,0,2,1));   // (y0 z0 y1 y2)
+    __m128 t2 = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(0,2,3,1));   // (z1 y2 y3 z2)
+    __m128 t3 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0,1,0,2));   // (z0 x0 z1 y1)
+    x = _mm_shuffle_ps(v0, t0, _MM_SHUFFLE(3,0,3,0));           // (x0 x1 x2 x3)
+    y = _mm_shuffle_ps(t1, t2, _MM_SHUFFLE(2,1,2,0));           // (y0 y1 y2 y3)
+    z = _mm_shuffle_ps(t3, v2, _MM_SHUFFLE(3,0,2,0));           // (z0 z1 z2 z3)
+}
+
+// the reverse of simd4LoadXyz(), store x, y, z vectors as 4 interleaved points
+inline void simd4StoreXyz(float* p, Simd4 x, Simd4 y, Simd4 z)
+{
+    __m128 lo = _mm_unpacklo_ps(x, y);                          // (x0 y0 x1 y1)
+    __m128 hi = _mm_unpackhi_ps(x, y);                          // (x2 y2 x3 y3)
+    __m128 t0 = _mm_shuffle_ps(z, lo, _MM_SHUFFLE(2,2,0,0));    // (z0 z0 x1 x1)
+    __m128 t1 = _mm_shuffle_ps(lo, z, _MM_SHUFFLE(1,1,3,3));    // (y1 y1 z1 z1)
+    __m128 t2 = _mm_shuffle_ps(z, hi, _MM_SHUFFLE(2,2,2,2));    // (z2 z2 x3 x3)
+    __m128 t3 = _mm_shuffle_ps(hi, z, _MM_SHUFFLE(3,3,3,3));    // (y3 y3 z3 z3)
+    _mm_storeu_ps(p,     _mm_shuffle_ps(lo, t0, _MM_SHUFFLE(2,0,1,0)));    // (x0 y0 z0 x1)
+    _mm_storeu_ps(p + 4, _mm_shuffle_ps(t1, hi, _MM_SHUFFLE(1,0,2,0)));    // (y1 z1 x2 y2)
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(2,0,2,0)));    // (z2 x3 y3 z3)
+}
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// common helpers for all widths
+///////////////////////////////////////////////////////////////////////////////
+// load the first count (<= SIMD_WIDTH) elements, the rest of lanes are 0
+inline SimdFloat simdLoadN(const float* p, int count)
+{
+    if(count >= SIMD_WIDTH)
+        return simdLoad(p);
+
+    float tmp[SIMD_WIDTH] = {0};
+    for(int i = 0; i < count; ++i)
+        tmp[i] = p[i];
+    return simdLoad(tmp);
+}
+
+// store the first count (<= SIMD_WIDTH) lanes only
+inline void simdStoreN(float* p, SimdFloat a, int count)
+{
+    if(count >= SIMD_WIDTH)
+    {
+        simdStore(p, a);
+        return;
+    }
+
+    float tmp[SIMD_WIDTH];
+    simdStore(tmp, a);
+    for(int i = 0; i < count; ++i)
+        p[i] = tmp[i];
+}
+
+// load the first count (<= SIMD_WIDTH) interleaved points (x,y,z,x,y,z,...)
+// to x, y, z vectors, the rest of lanes are 0
+inline void simdLoadXyzN(const float* p, int count, SimdFloat& x, SimdFloat& y, SimdFloat& z)
+{
+#if defined(SIMD_AVX)
+    if(count >= SIMD_WIDTH)
+    {
+        __m128 x0, y0, z0, x1, y1, z1;
+        simd4LoadXyz(p, x0, y0, z0);
+        simd4LoadXyz(p + 12, x1, y1, z1);
+        x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+        y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+        z = _mm256_insertf128_ps(_mm256_castps128_ps256(z0), z1, 1);
+        return;
+    }
+#elif defined(SIMD_SSE)
+    if(count >= SIMD_WIDTH)
+    {
+        simd4LoadXyz(p, x, y, z);
+        return;
+    }
+#endif
+
+    float tx[SIMD_WIDTH] = {0}, ty[SIMD_WIDTH] = {0}, tz[SIMD_WIDTH] = {0};
+    for(int i = 0; i < count && i < SIMD_WIDTH; ++i, p += 3)
+    {
+        tx[i] = p[0];
+        ty[i] = p[1];
+        tz[i] = p[2];
+    }
+    x = simdLoad(tx);
+    y = simdLoad(ty);
+    z = simdLoad(tz);
+}
+
+// store the first count (<= SIMD_WIDTH) lanes of x, y, z as interleaved points
+inline void simdStoreXyzN(float* p, SimdFloat x, SimdFloat y, SimdFloat z, int count)
+{
+#if defined(SIMD_AVX)
+    if(count >= SIMD_WIDTH)
+    {
+        simd4StoreXyz(p, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+        simd4StoreXyz(p + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+        return;
+    }
+#elif defined(SIMD_SSE)
+    if(count >= SIMD_WIDTH)
+    {
+        simd4StoreXyz(p, x, y, z);
+        return;
+    }
+#endif
+
+    float tx[SIMD_WIDTH], ty[SIMD_WIDTH], tz[SIMD_WIDTH];
+    simdStore(tx, x);
+    simdStore(ty, y);
+    simdStore(tz, z);
+    for(int i = 0; i < count && i < SIMD_WIDTH; ++i, p += 3)
+    {
+        p[0] = tx[i];
+        p[1] = ty[i];
+        p[2] = tz[i];
+    }
+}
+
+// unpack the bits of simdMoveMask() to one byte (0 or 1) per lane
+inline void simdStoreMaskN(unsigned char* p, int bits, int count)
+{
+    if(count > SIMD_WIDTH)
+        count = SIMD_WIDTH;
+    for(int i = 0; i < count; ++i)
+        p[i] = (unsigned char)((bits >> i) & 1);
+}
+
+// write code to the bytes of the lanes set in bits, the other bytes are unchanged
+inline void simdStoreCodeN(unsigned char* p, int bits, unsigned char code, int count)
+{
+    if(count > SIMD_WIDTH)
+        count = SIMD_WIDTH;
+    bits &= (1 << count) - 1;
+    for(int i = 0; bits; ++i, bits >>= 1)
+    {
+        if(bits & 1)
+            p[i] = code;
+    }
+}
+
+// count set bits of simdMoveMask()
+inline int simdCountBits(int bits)
+{
+    int count = 0;
+    for(; bits; bits &= bits - 1)
+        ++count;
+    return count;
+}
+
+// lanes are all true
+inline SimdFloat simdTrue()
+{
+    SimdFloat zero = simdZero();
+    return simdCmpEq(zero, zero);
+}
+
+// lanes of a are finite (not inf nor NaN), x - x is NaN for inf and NaN
+inline SimdFloat simdIsFinite(SimdFloat a)
+{
+    return simdCmpEq(simdSub(a, a), simdZero());
+}
+
+// lanes of !(valueSq > epsilon * scaleSq), or valueSq < FLT_MIN (0, subnormal)
+// same as isNearlyZero() in Intersection.h
+inline SimdFloat simdIsNearlyZero(SimdFloat valueSq, SimdFloat scaleSq, SimdFloat epsilon)
+{
+    SimdFloat large = simdCmpGt(valueSq, simdMul(epsilon, scaleSq));
+    return simdOr(simdAndNot(large, simdTrue()), simdCmpLt(valueSq, simdSet(FLT_MIN)));
+}
+
+#endif
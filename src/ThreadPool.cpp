@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////
+// ThreadPool.cpp
+// ==============
+// work-stealing thread pool to run a range kernel on multiple threads
+// parallelFor() splits a range [begin, end) into chunks of grain size, and
+// runs task(first, last) for each chunk on the worker threads.
+//
+// Dependencies: C++11 <thread>
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include "ThreadPool.h"
+
+
+
+// true if this thread is running a chunk, so nested parallelFor() runs inline
+static thread_local bool insideTask = false;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor: create (threadCount - 1) worker threads
+///////////////////////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(int threadCount, int grainSize) : task(0), remainCount(0), failed(false),
+                                                         generation(0), quit(false)
+{
+    if(threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    this->threadCount = std::max(threadCount, 1);
+    setGrainSize(grainSize);
+
+    for(int i = 0; i < this->threadCount; ++i)
+        queues.push_back(new Queue());
+    for(int i = 1; i < this->threadCount; ++i)
+        threads.push_back(std::thread(&ThreadPool::work, this, i));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dtor: stop and join all worker threads
+///////////////////////////////////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wakeCondition.notify_all();
+
+    for(size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    for(size_t i = 0; i < queues.size(); ++i)
+        delete queues[i];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// run task over [begin, end) with the default grain size
+///////////////////////////////////////////////////////////////////////////////
+void ThreadPool::parallelFor(int begin, int end, const Task& task, int alignment)
+{
+    parallelFor(begin, end, grainSize, task, alignment);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// split [begin, end) into chunks of grainSize, and run task for each chunk.
+// Each queue gets a contiguous run of chunks, so a thread walks the memory
+// forward until it runs out of its own chunks and starts stealing.
+// It waits for all chunks even if a chunk throws (the workers still use task),
+// then rethrows the first exception.
+///////////////////////////////////////////////////////////////////////////////
+void ThreadPool::parallelFor(int begin, int end, int grainSize, const Task& task, int alignment)
+{
+    if(begin >= end)
+        return;
+
+    // round up grain size to a multiple of alignment
+    alignment = std::max(alignment, 1);
+    grainSize = std::max(grainSize, 1);
+    grainSize = (grainSize + alignment - 1) / alignment * alignment;
+
+    int count = end - begin;
+    int chunkCount = (count - 1) / grainSize + 1;
+    if(threadCount == 1 || chunkCount == 1 || insideTask)
+    {
+        task(begin, end);
+        return;
+    }
+
+    std::lock_guard<std::mutex> jobLock(jobMutex);
+    this->task = &task;
+    remainCount = chunkCount;
+    failed = false;
+
+    // distribute chunks to the queues
+    for(int q = 0; q < threadCount; ++q)
+    {
+        int firstChunk = (int)((long long)chunkCount * q / threadCount);
+        int lastChunk = (int)((long long)chunkCount * (q + 1) / threadCount);
+
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for(int k = firstChunk; k < lastChunk; ++k)
+        {
+            Range range;
+            range.first = begin + k * grainSize;
+            range.last = std::min(range.first + grainSize, end);
+            queues[q]->ranges.push_back(range);
+        }
+    }
+
+    // wake up workers
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+    }
+    wakeCondition.notify_all();
+
+    // the calling thread works as thread 0
+    while(runNext(0))
+        ;
+
+    // wait for the chunks still running on other threads
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(remainCount > 0)
+            doneCondition.wait(lock);
+        this->task = 0;
+        error = exception;
+        exception = 0;
+    }
+    if(error)
+        std::rethrow_exception(error);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take a chunk from the front of own queue, or steal one from the back of the
+// other queues, then run it. Return false if all queues are empty.
+// An exception of the task is kept for parallelFor(), and the chunk is still
+// counted as done. The chunks after a failure are skipped.
+///////////////////////////////////////////////////////////////////////////////
+bool ThreadPool::runNext(int id)
+{
+    Range range;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(queues[id]->mutex);
+        if(!queues[id]->ranges.empty())
+        {
+            range = queues[id]->ranges.front();
+            queues[id]->ranges.pop_front();
+            found = true;
+        }
+    }
+
+    for(int i = 1; i < threadCount && !found; ++i)
+    {
+        Queue* victim = queues[(id + i) % threadCount];
+        std::lock_guard<std::mutex> lock(victim->mutex);
+        if(!victim->ranges.empty())
+        {
+            range = victim->ranges.back();
+            victim->ranges.pop_back();
+            found = true;
+        }
+    }
+
+    if(!found)
+        return false;
+
+    if(!failed)
+    {
+        insideTask = true;
+        try
+        {
+            (*task)(range.first, range.last);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!exception)
+                exception = std::current_exception();
+            failed = true;
+        }
+        insideTask = false;
+    }
+
+    // the last chunk wakes up the calling thread
+    if(remainCount.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        doneCondition.notify_all();
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// worker thread: sleep until a new job, then run chunks until none left
+///////////////////////////////////////////////////////////////////////////////
+void ThreadPool::work(int id)
+{
+    unsigned int seen = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while(!quit && generation == seen)
+                wakeCondition.wait(lock);
+            if(quit)
+                return;
+            seen = generation;
+        }
+
+        while(runNext(id))
+            ;
+    }
+}
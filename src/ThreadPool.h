@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+// ThreadPool.h
+// ============
+// work-stealing thread pool to run a range kernel on multiple threads
+// parallelFor() splits a range [begin, end) into chunks of grain size, and
+// runs task(first, last) for each chunk on the worker threads.
+//
+// NOTE:
+// 1. Each thread owns a queue of chunks. A thread takes the chunks from the
+//    front of its own queue, and steals from the back of the others' queues
+//    when its own queue is empty.
+// 2. The calling thread also works as one of the threads, so a pool with N
+//    threads creates N-1 worker threads. parallelFor() returns after all
+//    chunks are done.
+// 3. The chunks are [begin + k*grainSize, begin + (k+1)*grainSize). The grain
+//    size is rounded up to a multiple of alignment, so a kernel can keep its
+//    chunks on SIMD_WIDTH (or byte) boundaries.
+// 4. parallelFor() called inside a task runs the range on the same thread.
+// 5. Use the global parallelFor(pool, ...) to run on the calling thread only
+//    if pool is NULL.
+// 6. If a task throws an exception, the chunks not started yet are skipped,
+//    and parallelFor() rethrows the first exception on the calling thread
+//    after all running chunks are finished.
+//
+// Dependencies: C++11 <thread>
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef THREAD_POOL_H_DEF
+#define THREAD_POOL_H_DEF
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    // task(first, last) processes the elements in [first, last)
+    typedef std::function<void(int, int)> Task;
+
+    // ctor/dtor
+    // threadCount=0 uses all hardware threads
+    ThreadPool(int threadCount=0, int grainSize=4096);
+    ~ThreadPool();
+
+    // setters/getters
+    int getThreadCount() const              { return threadCount; }
+    void setGrainSize(int size)             { grainSize = (size > 0) ? size : 1; }
+    int getGrainSize() const                { return grainSize; }
+
+    // run task over [begin, end), with the default or a given grain size
+    void parallelFor(int begin, int end, const Task& task, int alignment=1);
+    void parallelFor(int begin, int end, int grainSize, const Task& task, int alignment=1);
+
+protected:
+
+private:
+    struct Range
+    {
+        int first;
+        int last;
+    };
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    void work(int id);                      // loop of worker threads
+    bool runNext(int id);                   // run a chunk of own or stolen queue
+
+    // disable copy
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    int threadCount;                        // including the calling thread
+    int grainSize;                          // default # of elements per chunk
+    std::vector<std::thread> threads;       // worker threads (threadCount - 1)
+    std::vector<Queue*> queues;             // a queue per thread, [0] is the caller's
+
+    const Task* task;                       // task of the current job
+    std::atomic<int> remainCount;           // # of unfinished chunks
+    std::atomic<bool> failed;               // a chunk threw, skip the rest
+    std::exception_ptr exception;           // first exception of the job
+    unsigned int generation;                // incremented per job to wake workers
+    bool quit;
+    std::mutex jobMutex;                    // one job at a time
+    std::mutex mutex;                       // for generation, quit, exception and remainCount = 0
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// run task over [begin, end) with pool, or on this thread if pool is NULL
+///////////////////////////////////////////////////////////////////////////////
+inline void parallelFor(ThreadPool* pool, int begin, int end, const ThreadPool::Task& task, int alignment=1)
+{
+    if(pool)
+        pool->parallelFor(begin, end, task, alignment);
+    else if(begin < end)
+        task(begin, end);
+}
+
+#endif
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// Vec3A.cpp
+// =========
+// 3D vector padded to 16 bytes for SSE
+//
+// Dependencies: Vector3, Simd
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Vec3A.h"
+
+// convert() loads 4 Vector3 as 3 floats x 4
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be 3 floats");
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy Vector3 array to Vec3A array
+// 4 packed vectors (48 bytes) are 3 SSE loads:
+// a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3)
+///////////////////////////////////////////////////////////////////////////////
+void Vec3A::convert(const Vector3* src, Vec3A* dst, int count)
+{
+    int i = 0;
+#if defined(SIMD4)
+    const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));    // clear w
+    for(; i + 4 <= count; i += 4)
+    {
+        const float* p = &src[i].x;
+        __m128 a = _mm_loadu_ps(p);
+        __m128 b = _mm_loadu_ps(p + 4);
+        __m128 c = _mm_loadu_ps(p + 8);
+
+        __m128 t = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0,0,3,3));              // x1 x1 y1 y1
+        __m128 v1 = _mm_shuffle_ps(t, b, _MM_SHUFFLE(1,1,2,0));             // x1 y1 z1 z1
+        __m128 v2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0,0,3,2));             // x2 y2 z2 z2
+        __m128 v3 = _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(c), 4)); // x3 y3 z3 0
+
+        _mm_store_ps(&dst[i].x,   _mm_and_ps(a, mask));
+        _mm_store_ps(&dst[i+1].x, _mm_and_ps(v1, mask));
+        _mm_store_ps(&dst[i+2].x, _mm_and_ps(v2, mask));
+        _mm_store_ps(&dst[i+3].x, v3);
+    }
+#endif
+    for(; i < count; ++i)
+        dst[i] = Vec3A(src[i].x, src[i].y, src[i].z);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy Vec3A array to Vector3 array, the reverse of above
+///////////////////////////////////////////////////////////////////////////////
+void Vec3A::convert(const Vec3A* src, Vector3* dst, int count)
+{
+    int i = 0;
+#if defined(SIMD4)
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 v0 = src[i].get();
+        __m128 v1 = src[i+1].get();
+        __m128 v2 = src[i+2].get();
+        __m128 v3 = src[i+3].get();
+
+        __m128 t = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0,0,2,2));            // z0 z0 x1 x1
+        __m128 a = _mm_shuffle_ps(v0, t, _MM_SHUFFLE(2,0,1,0));             // x0 y0 z0 x1
+        __m128 b = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1,0,2,1));            // y1 z1 x2 y2
+        t = _mm_shuffle_ps(v2, v3, _MM_SHUFFLE(0,0,2,2));                   // z2 z2 x3 x3
+        __m128 c = _mm_shuffle_ps(t, v3, _MM_SHUFFLE(2,1,2,0));             // z2 x3 y3 z3
+
+        float* p = &dst[i].x;
+        _mm_storeu_ps(p, a);
+        _mm_storeu_ps(p + 4, b);
+        _mm_storeu_ps(p + 8, c);
+    }
+#endif
+    for(; i < count; ++i)
+        dst[i] = src[i].toVector3();
+}
@@ -0,0 +1,310 @@
+///////////////////////////////////////////////////////////////////////////////
+// Vec3A.h
+// =======
+// 3D vector padded to 16 bytes and aligned at 16 bytes, so it is loaded to a
+// single SSE register (__m128) at once. It has the same interface as Vector3,
+// and dot/cross/normalize are a few SSE instructions instead of the scalar
+// code of the 12-byte Vector3.
+//
+// NOTE:
+// 1. w is the padding, and it is ignored by all operations.
+// 2. dot() uses dpps if SSE4.1 is available (-msse4.1 or -mavx), otherwise
+//    shuffles and adds. cross() is 3 shuffles, 2 multiplies and 1 subtract.
+// 3. It falls back to plain float on the builds without SSE (SIMD4 is not
+//    defined in Simd.h).
+// 4. It converts implicitly from Vector3, and toVector3() converts back.
+//    convert() copies arrays of Vector3 to/from Vec3A 4 vectors at once
+//    (3 loads and 4 stores with shuffles only).
+// 5. A single operation on Vector3 data does not gain from it; the 12-byte
+//    load and the horizontal add of dot() cost as much as the scalar code.
+//    Convert the arrays once, and keep the data in Vec3A for the loops.
+//
+// Dependencies: Vector3, Simd
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VEC3A_H_DEF
+#define VEC3A_H_DEF
+
+#include <cmath>
+#include <iostream>
+#include "Vectors.h"
+#include "Simd.h"
+#if defined(SIMD4) && (defined(__SSE4_1__) || defined(__AVX__))
+#include <smmintrin.h>
+#endif
+
+struct alignas(16) Vec3A
+{
+    float x;
+    float y;
+    float z;
+    float w;    // padding
+
+    // ctors
+    constexpr Vec3A() : x(0), y(0), z(0), w(0) {}
+    constexpr Vec3A(float x, float y, float z) : x(x), y(y), z(z), w(0) {}
+    Vec3A(const Vector3& v);                            // from Vector3
+#if defined(SIMD4)
+    explicit Vec3A(Simd4 v)                             { _mm_store_ps(&x, v); }
+    Simd4       get() const                             { return _mm_load_ps(&x); }
+#endif
+    Vector3     toVector3() const                       { return Vector3(x, y, z); }
+
+    // utils functions
+    Vec3A&      set(float x, float y, float z);
+    float       length() const;                         //
+    float       distance(const Vec3A& vec) const;       // distance between two vectors
+    float       angle(const Vec3A& vec) const;          // angle between two vectors
+    Vec3A&      normalize();                            //
+    float       dot(const Vec3A& vec) const;            // dot product
+    Vec3A       cross(const Vec3A& vec) const;          // cross product
+    bool        equal(const Vec3A& vec, float e) const; // compare with epsilon
+
+    // operators
+    Vec3A       operator-() const;                      // unary operator (negate)
+    Vec3A       operator+(const Vec3A& rhs) const;      // add rhs
+    Vec3A       operator-(const Vec3A& rhs) const;      // subtract rhs
+    Vec3A&      operator+=(const Vec3A& rhs);           // add rhs and update this object
+    Vec3A&      operator-=(const Vec3A& rhs);           // subtract rhs and update this object
+    Vec3A       operator*(const float scale) const;     // scale
+    Vec3A       operator*(const Vec3A& rhs) const;      // multiply each element
+    Vec3A&      operator*=(const float scale);          // scale and update this object
+    Vec3A&      operator*=(const Vec3A& rhs);           // multiply each element and update this object
+    Vec3A       operator/(const float scale) const;     // inverse scale
+    Vec3A&      operator/=(const float scale);          // scale and update this object
+    bool        operator==(const Vec3A& rhs) const;     // exact compare, no epsilon
+    bool        operator!=(const Vec3A& rhs) const;     // exact compare, no epsilon
+    bool        operator<(const Vec3A& rhs) const;      // comparison for sort
+    float       operator[](int index) const;            // subscript operator v[0], v[1]
+    float&      operator[](int index);                  // subscript operator v[0], v[1]
+
+    // copy count vectors between Vector3 and Vec3A arrays
+    static void convert(const Vector3* src, Vec3A* dst, int count);
+    static void convert(const Vec3A* src, Vector3* dst, int count);
+
+    friend Vec3A operator*(const float a, const Vec3A& vec);
+    friend std::ostream& operator<<(std::ostream& os, const Vec3A& vec);
+};
+
+static_assert(sizeof(Vec3A) == 16, "Vec3A must be 16 bytes");
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inline functions for Vec3A
+///////////////////////////////////////////////////////////////////////////////
+inline Vec3A::Vec3A(const Vector3& v)
+{
+#if defined(SIMD4)
+    _mm_store_ps(&x, _mm_set_ps(0, v.z, v.y, v.x));
+#else
+    x = v.x; y = v.y; z = v.z; w = 0;
+#endif
+}
+
+inline Vec3A Vec3A::operator-() const {
+#if defined(SIMD4)
+    return Vec3A(_mm_sub_ps(_mm_setzero_ps(), get()));
+#else
+    return Vec3A(-x, -y, -z);
+#endif
+}
+
+inline Vec3A Vec3A::operator+(const Vec3A& rhs) const {
+#if defined(SIMD4)
+    return Vec3A(_mm_add_ps(get(), rhs.get()));
+#else
+    return Vec3A(x+rhs.x, y+rhs.y, z+rhs.z);
+#endif
+}
+
+inline Vec3A Vec3A::operator-(const Vec3A& rhs) const {
+#if defined(SIMD4)
+    return Vec3A(_mm_sub_ps(get(), rhs.get()));
+#else
+    return Vec3A(x-rhs.x, y-rhs.y, z-rhs.z);
+#endif
+}
+
+inline Vec3A& Vec3A::operator+=(const Vec3A& rhs) {
+    *this = *this + rhs; return *this;
+}
+
+inline Vec3A& Vec3A::operator-=(const Vec3A& rhs) {
+    *this = *this - rhs; return *this;
+}
+
+inline Vec3A Vec3A::operator*(const float a) const {
+#if defined(SIMD4)
+    return Vec3A(_mm_mul_ps(get(), _mm_set1_ps(a)));
+#else
+    return Vec3A(x*a, y*a, z*a);
+#endif
+}
+
+inline Vec3A Vec3A::operator*(const Vec3A& rhs) const {
+#if defined(SIMD4)
+    return Vec3A(_mm_mul_ps(get(), rhs.get()));
+#else
+    return Vec3A(x*rhs.x, y*rhs.y, z*rhs.z);
+#endif
+}
+
+inline Vec3A& Vec3A::operator*=(const float a) {
+    *this = *this * a; return *this;
+}
+
+inline Vec3A& Vec3A::operator*=(const Vec3A& rhs) {
+    *this = *this * rhs; return *this;
+}
+
+inline Vec3A Vec3A::operator/(const float a) const {
+#if defined(SIMD4)
+    return Vec3A(_mm_div_ps(get(), _mm_set1_ps(a)));
+#else
+    return Vec3A(x/a, y/a, z/a);
+#endif
+}
+
+inline Vec3A& Vec3A::operator/=(const float a) {
+    *this = *this / a; return *this;
+}
+
+inline bool Vec3A::operator==(const Vec3A& rhs) const {
+#if defined(SIMD4)
+    return (_mm_movemask_ps(_mm_cmpeq_ps(get(), rhs.get())) & 7) == 7;
+#else
+    return (x == rhs.x) && (y == rhs.y) && (z == rhs.z);
+#endif
+}
+
+inline bool Vec3A::operator!=(const Vec3A& rhs) const {
+    return !(*this == rhs);
+}
+
+inline bool Vec3A::operator<(const Vec3A& rhs) const {
+    if(x < rhs.x) return true;
+    if(x > rhs.x) return false;
+    if(y < rhs.y) return true;
+    if(y > rhs.y) return false;
+    if(z < rhs.z) return true;
+    if(z > rhs.z) return false;
+    return false;
+}
+
+inline float Vec3A::operator[](int index) const {
+    return (&x)[index];
+}
+
+inline float& Vec3A::operator[](int index) {
+    return (&x)[index];
+}
+
+inline Vec3A& Vec3A::set(float x, float y, float z) {
+    this->x = x; this->y = y; this->z = z; return *this;
+}
+
+inline float Vec3A::length() const {
+    return sqrtf(dot(*this));
+}
+
+inline float Vec3A::distance(const Vec3A& vec) const {
+    return (vec - *this).length();
+}
+
+inline float Vec3A::angle(const Vec3A& vec) const {
+    // return angle between [0, 180]
+    float l1 = this->length();
+    float l2 = vec.length();
+    float d = this->dot(vec);
+    float angle = acosf(d / (l1 * l2)) / 3.141592f * 180.0f;
+    return angle;
+}
+
+inline Vec3A& Vec3A::normalize() {
+    float invLength = 1.0f / sqrtf(dot(*this));
+#if defined(SIMD4)
+    _mm_store_ps(&x, _mm_mul_ps(get(), _mm_set_ps(0, invLength, invLength, invLength)));
+#else
+    x *= invLength;
+    y *= invLength;
+    z *= invLength;
+#endif
+    return *this;
+}
+
+inline float Vec3A::dot(const Vec3A& rhs) const {
+#if defined(SIMD4) && (defined(__SSE4_1__) || defined(__AVX__))
+    // multiply x, y, z (bits 4-6) and write the sum to lane 0 (bit 0)
+    return _mm_cvtss_f32(_mm_dp_ps(get(), rhs.get(), 0x71));
+#elif defined(SIMD4)
+    __m128 m = _mm_mul_ps(get(), rhs.get());
+    __m128 s = _mm_add_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1,1,1,1)));   // x + y
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_movehl_ps(m, m)));               // + z
+#else
+    return (x*rhs.x + y*rhs.y + z*rhs.z);
+#endif
+}
+
+inline Vec3A Vec3A::cross(const Vec3A& rhs) const {
+#if defined(SIMD4)
+    // a x b = (a * b.yzx - a.yzx * b).yzx
+    __m128 a = get();
+    __m128 b = rhs.get();
+    __m128 a1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3,0,2,1));
+    __m128 b1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3,0,2,1));
+    __m128 c = _mm_sub_ps(_mm_mul_ps(a, b1), _mm_mul_ps(a1, b));
+    return Vec3A(_mm_shuffle_ps(c, c, _MM_SHUFFLE(3,0,2,1)));
+#else
+    return Vec3A(y*rhs.z - z*rhs.y, z*rhs.x - x*rhs.z, x*rhs.y - y*rhs.x);
+#endif
+}
+
+inline bool Vec3A::equal(const Vec3A& rhs, float epsilon) const {
+#if defined(SIMD4)
+    __m128 d = _mm_sub_ps(get(), rhs.get());
+    d = _mm_andnot_ps(_mm_set1_ps(-0.0f), d);                               // |d|
+    return (_mm_movemask_ps(_mm_cmplt_ps(d, _mm_set1_ps(epsilon))) & 7) == 7;
+#else
+    return fabs(x - rhs.x) < epsilon && fabs(y - rhs.y) < epsilon && fabs(z - rhs.z) < epsilon;
+#endif
+}
+
+inline Vec3A operator*(const float a, const Vec3A& vec) {
+    return vec * a;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Vec3A& vec) {
+    os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ")";
+    return os;
+}
+
+// fused operations, same as Vector3
+// a * u + v
+inline Vec3A mulAdd(float a, const Vec3A& u, const Vec3A& v) {
+#if defined(SIMD4)
+    return Vec3A(simd4MulAdd(simd4Set(a), u.get(), v.get()));
+#else
+    return Vec3A(a*u.x + v.x, a*u.y + v.y, a*u.z + v.z);
+#endif
+}
+
+// a * u + b * v
+inline Vec3A mulAdd(float a, const Vec3A& u, float b, const Vec3A& v) {
+#if defined(SIMD4)
+    return Vec3A(simd4MulAdd(simd4Set(a), u.get(), simd4Mul(simd4Set(b), v.get())));
+#else
+    return Vec3A(a*u.x + b*v.x, a*u.y + b*v.y, a*u.z + b*v.z);
+#endif
+}
+
+// (u x v) * s
+inline Vec3A crossScale(const Vec3A& u, const Vec3A& v, float s) {
+    return u.cross(v) * s;
+}
+// END OF VEC3A ///////////////////////////////////////////////////////////////
+
+#endif
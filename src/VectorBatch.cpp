@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// VectorBatch.cpp
+// ===============
+// bulk normalize, length and distance of 3D vectors in float arrays
+//
+// Dependencies: Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cfloat>
+#include <cmath>
+#include "VectorBatch.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 1 / sqrt(x) with the given accuracy, 0 if x < FLT_MIN (zero vector)
+// Newton step: r' = r * (1.5 - 0.5 * x * r * r)
+///////////////////////////////////////////////////////////////////////////////
+static inline SimdFloat inverseSqrt(SimdFloat x, SqrtAccuracy accuracy)
+{
+    SimdFloat r;
+    if(accuracy == SQRT_EXACT)
+    {
+        r = simdDiv(simdSet(1.0f), simdSqrt(x));
+    }
+    else
+    {
+        r = simdRSqrt(x);
+        if(accuracy == SQRT_NEWTON)
+        {
+            SimdFloat halfX = simdMul(simdSet(0.5f), x);
+            r = simdMul(r, simdSub(simdSet(1.5f), simdMul(halfX, simdMul(r, r))));
+        }
+    }
+    return simdAnd(simdCmpGe(x, simdSet(FLT_MIN)), r);
+}
+
+// sqrt(x) = x * (1 / sqrt(x)), and 0 for x = 0
+// inf * (1 / sqrt(inf)) = inf * 0 is NaN, so x is kept for x = inf
+static inline SimdFloat squareRoot(SimdFloat x, SqrtAccuracy accuracy)
+{
+    if(accuracy == SQRT_EXACT)
+        return simdSqrt(x);
+    else
+        return simdSelect(simdCmpEq(x, simdSet(INFINITY)), x, simdMul(x, inverseSqrt(x, accuracy)));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dst[i] = src[i] / |src[i]|
+///////////////////////////////////////////////////////////////////////////////
+void normalizeVectors(const float* src, int count, float* dst, SqrtAccuracy accuracy,
+                      ThreadPool* pool)
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat x, y, z;
+            simdLoadXyzN(src + i * 3, n, x, y, z);
+
+            SimdFloat lengthSq = simdMulAdd(x, x, simdMulAdd(y, y, simdMul(z, z)));
+            SimdFloat invLength = inverseSqrt(lengthSq, accuracy);
+            simdStoreXyzN(dst + i * 3, simdMul(x, invLength), simdMul(y, invLength),
+                          simdMul(z, invLength), n);
+        }
+    }, SIMD_WIDTH);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// lengths[i] = |vectors[i]|
+///////////////////////////////////////////////////////////////////////////////
+void computeLengths(const float* vectors, int count, float* lengths, SqrtAccuracy accuracy,
+                    ThreadPool* pool)
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat x, y, z;
+            simdLoadXyzN(vectors + i * 3, n, x, y, z);
+
+            SimdFloat lengthSq = simdMulAdd(x, x, simdMulAdd(y, y, simdMul(z, z)));
+            simdStoreN(lengths + i, squareRoot(lengthSq, accuracy), n);
+        }
+    }, SIMD_WIDTH);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// distances[i] = |points2[i] - points1[i]|
+///////////////////////////////////////////////////////////////////////////////
+void computeDistances(const float* points1, const float* points2, int count, float* distances,
+                      SqrtAccuracy accuracy, ThreadPool* pool)
+{
+    parallelFor(pool, 0, count, [&](int first, int last)
+    {
+        for(int i = first; i < last; i += SIMD_WIDTH)
+        {
+            int n = last - i;
+            SimdFloat x1, y1, z1, x2, y2, z2;
+            simdLoadXyzN(points1 + i * 3, n, x1, y1, z1);
+            simdLoadXyzN(points2 + i * 3, n, x2, y2, z2);
+
+            SimdFloat x = simdSub(x2, x1);
+            SimdFloat y = simdSub(y2, y1);
+            SimdFloat z = simdSub(z2, z1);
+            SimdFloat lengthSq = simdMulAdd(x, x, simdMulAdd(y, y, simdMul(z, z)));
+            simdStoreN(distances + i, squareRoot(lengthSq, accuracy), n);
+        }
+    }, SIMD_WIDTH);
+}
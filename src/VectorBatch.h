@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////
+// VectorBatch.h
+// =============
+// bulk normalize, length and distance of 3D vectors in float arrays
+// The vectors are interleaved (x,y,z,x,y,z,...), same as the vertex and
+// normal arrays, and SIMD_WIDTH vectors are computed at once. 1/sqrt(x) is
+// rsqrtps with 0 or 1 Newton-Raphson step, or sqrtps and divps.
+//
+// NOTE:
+// 1. The accuracy of 1/sqrt(x):
+//    SQRT_FAST  : rsqrtps only, relative error < 1.5 * 2^-12 (~0.0004)
+//    SQRT_NEWTON: 1 Newton step, relative error ~2^-22 (a few ulp)
+//    SQRT_EXACT : 1 / sqrt(x), same as Vector3::normalize()
+//    The builds without SSE use 1 / sqrtf(x) for all.
+// 2. A zero vector (length^2 < FLT_MIN) stays zero instead of NaN, and the
+//    length of a vector whose length^2 overflows is inf for all accuracies.
+// 3. dst of normalizeVectors() can be same as src.
+// 4. The functions run on the threads of pool if it is given.
+//
+// Dependencies: Simd, ThreadPool
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECTOR_BATCH_H_DEF
+#define VECTOR_BATCH_H_DEF
+
+#include "Simd.h"
+#include "ThreadPool.h"
+
+enum SqrtAccuracy
+{
+    SQRT_FAST   = 0,    // rsqrtps
+    SQRT_NEWTON = 1,    // rsqrtps + 1 Newton-Raphson step
+    SQRT_EXACT  = 2     // sqrtps + divps
+};
+
+// count vectors of 3 floats each
+void normalizeVectors(const float* src, int count, float* dst,
+                      SqrtAccuracy accuracy=SQRT_NEWTON, ThreadPool* pool=0);
+void computeLengths(const float* vectors, int count, float* lengths,
+                    SqrtAccuracy accuracy=SQRT_NEWTON, ThreadPool* pool=0);
+void computeDistances(const float* points1, const float* points2, int count, float* distances,
+                      SqrtAccuracy accuracy=SQRT_NEWTON, ThreadPool* pool=0);
+
+#endif
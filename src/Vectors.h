@@ -2,10 +2,19 @@
 // Vectors.h
 // =========
 // 2D/3D/4D vectors
+// Vector3 is a template of the element type, Vector3T<T>; Vector3 is the
+// float version and Vector3d is the double version.
+//
+// The ctors and the operators returning a new vector (+, -, *, /, ==, !=,
+// dot, cross) are constexpr, so constant vectors are folded at compile time.
+//
+// The fused functions of Vector3, mulAdd() and crossScale(), compute a chain
+// of operators in one expression without the intermediate vectors, e.g.
+// mulAdd(t, v, p) instead of p + (t * v).
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2007-02-14
-// UPDATED: 2020-06-29
+// UPDATED: 2026-10-17
 //
 // Copyright (C) 2007-2020 Song Ho Ahn
 ///////////////////////////////////////////////////////////////////////////////
@@ -15,6 +24,7 @@
 #define VECTORS_H_DEF
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -26,36 +36,36 @@ struct Vector2
     float y;
 
     // ctors
-    Vector2() : x(0), y(0) {};
-    Vector2(float x, float y) : x(x), y(y) {};
+    constexpr Vector2() : x(0), y(0) {}
+    constexpr Vector2(float x, float y) : x(x), y(y) {}
 
     // utils functions
     Vector2&    set(float x, float y);
     float       length() const;                         //
     float       distance(const Vector2& vec) const;     // distance between two vectors
     Vector2&    normalize();                            //
-    float       dot(const Vector2& vec) const;          // dot product
+    constexpr float dot(const Vector2& vec) const;      // dot product
     bool        equal(const Vector2& vec, float e) const; // compare with epsilon
 
     // operators
-    Vector2     operator-() const;                      // unary operator (negate)
-    Vector2     operator+(const Vector2& rhs) const;    // add rhs
-    Vector2     operator-(const Vector2& rhs) const;    // subtract rhs
+    constexpr Vector2 operator-() const;                // unary operator (negate)
+    constexpr Vector2 operator+(const Vector2& rhs) const; // add rhs
+    constexpr Vector2 operator-(const Vector2& rhs) const; // subtract rhs
     Vector2&    operator+=(const Vector2& rhs);         // add rhs and update this object
     Vector2&    operator-=(const Vector2& rhs);         // subtract rhs and update this object
-    Vector2     operator*(const float scale) const;     // scale
-    Vector2     operator*(const Vector2& rhs) const;    // multiply each element
+    constexpr Vector2 operator*(const float scale) const; // scale
+    constexpr Vector2 operator*(const Vector2& rhs) const; // multiply each element
     Vector2&    operator*=(const float scale);          // scale and update this object
     Vector2&    operator*=(const Vector2& rhs);         // multiply each element and update this object
-    Vector2     operator/(const float scale) const;     // inverse scale
+    constexpr Vector2 operator/(const float scale) const; // inverse scale
     Vector2&    operator/=(const float scale);          // scale and update this object
-    bool        operator==(const Vector2& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Vector2& rhs) const;   // exact compare, no epsilon
+    constexpr bool operator==(const Vector2& rhs) const; // exact compare, no epsilon
+    constexpr bool operator!=(const Vector2& rhs) const; // exact compare, no epsilon
     bool        operator<(const Vector2& rhs) const;    // comparison for sort
     float       operator[](int index) const;            // subscript operator v[0], v[1]
     float&      operator[](int index);                  // subscript operator v[0], v[1]
 
-    friend Vector2 operator*(const float a, const Vector2 vec);
+    friend constexpr Vector2 operator*(const float a, const Vector2 vec);
     friend std::ostream& operator<<(std::ostream& os, const Vector2& vec);
 };
 
@@ -63,51 +73,63 @@ struct Vector2
 
 ///////////////////////////////////////////////////////////////////////////////
 // 3D vector
+// T is float or double
 ///////////////////////////////////////////////////////////////////////////////
-struct Vector3
+template<typename T>
+struct Vector3T
 {
-    float x;
-    float y;
-    float z;
+    T x;
+    T y;
+    T z;
 
     // ctors
-    Vector3() : x(0), y(0), z(0) {};
-    Vector3(float x, float y, float z) : x(x), y(y), z(z) {};
+    constexpr Vector3T() : x(0), y(0), z(0) {}
+    constexpr Vector3T(T x, T y, T z) : x(x), y(y), z(z) {}
 
     // utils functions
-    Vector3&    set(float x, float y, float z);
-    float       length() const;                         //
-    float       distance(const Vector3& vec) const;     // distance between two vectors
-    float       angle(const Vector3& vec) const;        // angle between two vectors
-    Vector3&    normalize();                            //
-    float       dot(const Vector3& vec) const;          // dot product
-    Vector3     cross(const Vector3& vec) const;        // cross product
-    bool        equal(const Vector3& vec, float e) const; // compare with epsilon
+    Vector3T&   set(T x, T y, T z);
+    T           length() const;                         //
+    T           distance(const Vector3T& vec) const;    // distance between two vectors
+    T           angle(const Vector3T& vec) const;       // angle between two vectors
+    Vector3T&   normalize();                            //
+    constexpr T dot(const Vector3T& vec) const;         // dot product
+    constexpr Vector3T cross(const Vector3T& vec) const; // cross product
+    bool        equal(const Vector3T& vec, T e) const;  // compare with epsilon
 
     // operators
-    Vector3     operator-() const;                      // unary operator (negate)
-    Vector3     operator+(const Vector3& rhs) const;    // add rhs
-    Vector3     operator-(const Vector3& rhs) const;    // subtract rhs
-    Vector3&    operator+=(const Vector3& rhs);         // add rhs and update this object
-    Vector3&    operator-=(const Vector3& rhs);         // subtract rhs and update this object
-    Vector3     operator*(const float scale) const;     // scale
-    Vector3     operator*(const Vector3& rhs) const;    // multiplay each element
-    Vector3&    operator*=(const float scale);          // scale and update this object
-    Vector3&    operator*=(const Vector3& rhs);         // product each element and update this object
-    Vector3     operator/(const float scale) const;     // inverse scale
-    Vector3&    operator/=(const float scale);          // scale and update this object
-    bool        operator==(const Vector3& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Vector3& rhs) const;   // exact compare, no epsilon
-    bool        operator<(const Vector3& rhs) const;    // comparison for sort
-    float       operator[](int index) const;            // subscript operator v[0], v[1]
-    float&      operator[](int index);                  // subscript operator v[0], v[1]
-
-    friend Vector3 operator*(const float a, const Vector3 vec);
-    friend std::ostream& operator<<(std::ostream& os, const Vector3& vec);
+    constexpr Vector3T operator-() const;               // unary operator (negate)
+    constexpr Vector3T operator+(const Vector3T& rhs) const; // add rhs
+    constexpr Vector3T operator-(const Vector3T& rhs) const; // subtract rhs
+    Vector3T&   operator+=(const Vector3T& rhs);        // add rhs and update this object
+    Vector3T&   operator-=(const Vector3T& rhs);        // subtract rhs and update this object
+    constexpr Vector3T operator*(const T scale) const;  // scale
+    constexpr Vector3T operator*(const Vector3T& rhs) const; // multiplay each element
+    Vector3T&   operator*=(const T scale);              // scale and update this object
+    Vector3T&   operator*=(const Vector3T& rhs);        // product each element and update this object
+    constexpr Vector3T operator/(const T scale) const;  // inverse scale
+    Vector3T&   operator/=(const T scale);              // scale and update this object
+    constexpr bool operator==(const Vector3T& rhs) const; // exact compare, no epsilon
+    constexpr bool operator!=(const Vector3T& rhs) const; // exact compare, no epsilon
+    bool        operator<(const Vector3T& rhs) const;   // comparison for sort
+    T           operator[](int index) const;            // subscript operator v[0], v[1]
+    T&          operator[](int index);                  // subscript operator v[0], v[1]
+
+    friend constexpr Vector3T operator*(const T a, const Vector3T& vec) {
+        return Vector3T(a*vec.x, a*vec.y, a*vec.z);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const Vector3T& vec) {
+        os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ")";
+        return os;
+    }
 };
 
 
 
+typedef Vector3T<float>  Vector3;
+typedef Vector3T<double> Vector3d;
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // 4D vector
 ///////////////////////////////////////////////////////////////////////////////
@@ -119,48 +141,51 @@ struct Vector4
     float w;
 
     // ctors
-    Vector4() : x(0), y(0), z(0), w(0) {};
-    Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {};
+    constexpr Vector4() : x(0), y(0), z(0), w(0) {}
+    constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
 
     // utils functions
     Vector4&    set(float x, float y, float z, float w);
     float       length() const;                         //
     float       distance(const Vector4& vec) const;     // distance between two vectors
     Vector4&    normalize();                            //
-    float       dot(const Vector4& vec) const;          // dot product
+    constexpr float dot(const Vector4& vec) const;      // dot product
     bool        equal(const Vector4& vec, float e) const; // compare with epsilon
 
     // operators
-    Vector4     operator-() const;                      // unary operator (negate)
-    Vector4     operator+(const Vector4& rhs) const;    // add rhs
-    Vector4     operator-(const Vector4& rhs) const;    // subtract rhs
+    constexpr Vector4 operator-() const;                // unary operator (negate)
+    constexpr Vector4 operator+(const Vector4& rhs) const; // add rhs
+    constexpr Vector4 operator-(const Vector4& rhs) const; // subtract rhs
     Vector4&    operator+=(const Vector4& rhs);         // add rhs and update this object
     Vector4&    operator-=(const Vector4& rhs);         // subtract rhs and update this object
-    Vector4     operator*(const float scale) const;     // scale
-    Vector4     operator*(const Vector4& rhs) const;    // multiply each element
+    constexpr Vector4 operator*(const float scale) const; // scale
+    constexpr Vector4 operator*(const Vector4& rhs) const; // multiply each element
     Vector4&    operator*=(const float scale);          // scale and update this object
     Vector4&    operator*=(const Vector4& rhs);         // multiply each element and update this object
-    Vector4     operator/(const float scale) const;     // inverse scale
+    constexpr Vector4 operator/(const float scale) const; // inverse scale
     Vector4&    operator/=(const float scale);          // scale and update this object
-    bool        operator==(const Vector4& rhs) const;   // exact compare, no epsilon
-    bool        operator!=(const Vector4& rhs) const;   // exact compare, no epsilon
+    constexpr bool operator==(const Vector4& rhs) const; // exact compare, no epsilon
+    constexpr bool operator!=(const Vector4& rhs) const; // exact compare, no epsilon
     bool        operator<(const Vector4& rhs) const;    // comparison for sort
     float       operator[](int index) const;            // subscript operator v[0], v[1]
     float&      operator[](int index);                  // subscript operator v[0], v[1]
 
-    friend Vector4 operator*(const float a, const Vector4 vec);
+    friend constexpr Vector4 operator*(const float a, const Vector4 vec);
     friend std::ostream& operator<<(std::ostream& os, const Vector4& vec);
 };
 
 
 
 // fast math routines from Doom3 SDK
+// The bits are copied with memcpy instead of a pointer cast (aliasing rule).
+// For arrays of vectors, use normalizeVectors() of VectorBatch.h instead.
 inline float invSqrt(float x)
 {
     float xhalf = 0.5f * x;
-    int i = *(int*)&x;          // get bits for floating value
+    int i;
+    std::memcpy(&i, &x, sizeof(x)); // get bits for floating value
     i = 0x5f3759df - (i>>1);    // gives initial guess
-    x = *(float*)&i;            // convert bits back to float
+    std::memcpy(&x, &i, sizeof(x)); // convert bits back to float
     x = x * (1.5f - xhalf*x*x); // Newton step
     return x;
 }
@@ -170,15 +195,15 @@ inline float invSqrt(float x)
 ///////////////////////////////////////////////////////////////////////////////
 // inline functions for Vector2
 ///////////////////////////////////////////////////////////////////////////////
-inline Vector2 Vector2::operator-() const {
+constexpr Vector2 Vector2::operator-() const {
     return Vector2(-x, -y);
 }
 
-inline Vector2 Vector2::operator+(const Vector2& rhs) const {
+constexpr Vector2 Vector2::operator+(const Vector2& rhs) const {
     return Vector2(x+rhs.x, y+rhs.y);
 }
 
-inline Vector2 Vector2::operator-(const Vector2& rhs) const {
+constexpr Vector2 Vector2::operator-(const Vector2& rhs) const {
     return Vector2(x-rhs.x, y-rhs.y);
 }
 
@@ -190,11 +215,11 @@ inline Vector2& Vector2::operator-=(const Vector2& rhs) {
     x -= rhs.x; y -= rhs.y; return *this;
 }
 
-inline Vector2 Vector2::operator*(const float a) const {
+constexpr Vector2 Vector2::operator*(const float a) const {
     return Vector2(x*a, y*a);
 }
 
-inline Vector2 Vector2::operator*(const Vector2& rhs) const {
+constexpr Vector2 Vector2::operator*(const Vector2& rhs) const {
     return Vector2(x*rhs.x, y*rhs.y);
 }
 
@@ -206,7 +231,7 @@ inline Vector2& Vector2::operator*=(const Vector2& rhs) {
     x *= rhs.x; y *= rhs.y; return *this;
 }
 
-inline Vector2 Vector2::operator/(const float a) const {
+constexpr Vector2 Vector2::operator/(const float a) const {
     return Vector2(x/a, y/a);
 }
 
@@ -214,11 +239,11 @@ inline Vector2& Vector2::operator/=(const float a) {
     x /= a; y /= a; return *this;
 }
 
-inline bool Vector2::operator==(const Vector2& rhs) const {
+constexpr bool Vector2::operator==(const Vector2& rhs) const {
     return (x == rhs.x) && (y == rhs.y);
 }
 
-inline bool Vector2::operator!=(const Vector2& rhs) const {
+constexpr bool Vector2::operator!=(const Vector2& rhs) const {
     return (x != rhs.x) || (y != rhs.y);
 }
 
@@ -263,7 +288,7 @@ inline Vector2& Vector2::normalize() {
     return *this;
 }
 
-inline float Vector2::dot(const Vector2& rhs) const {
+constexpr float Vector2::dot(const Vector2& rhs) const {
     return (x*rhs.x + y*rhs.y);
 }
 
@@ -271,7 +296,7 @@ inline bool Vector2::equal(const Vector2& rhs, float epsilon) const {
     return fabs(x - rhs.x) < epsilon && fabs(y - rhs.y) < epsilon;
 }
 
-inline Vector2 operator*(const float a, const Vector2 vec) {
+constexpr Vector2 operator*(const float a, const Vector2 vec) {
     return Vector2(a*vec.x, a*vec.y);
 }
 
@@ -287,59 +312,73 @@ inline std::ostream& operator<<(std::ostream& os, const Vector2& vec) {
 ///////////////////////////////////////////////////////////////////////////////
 // inline functions for Vector3
 ///////////////////////////////////////////////////////////////////////////////
-inline Vector3 Vector3::operator-() const {
-    return Vector3(-x, -y, -z);
+template<typename T>
+constexpr Vector3T<T> Vector3T<T>::operator-() const {
+    return Vector3T<T>(-x, -y, -z);
 }
 
-inline Vector3 Vector3::operator+(const Vector3& rhs) const {
-    return Vector3(x+rhs.x, y+rhs.y, z+rhs.z);
+template<typename T>
+constexpr Vector3T<T> Vector3T<T>::operator+(const Vector3T<T>& rhs) const {
+    return Vector3T<T>(x+rhs.x, y+rhs.y, z+rhs.z);
 }
 
-inline Vector3 Vector3::operator-(const Vector3& rhs) const {
-    return Vector3(x-rhs.x, y-rhs.y, z-rhs.z);
+template<typename T>
+constexpr Vector3T<T> Vector3T<T>::operator-(const Vector3T<T>& rhs) const {
+    return Vector3T<T>(x-rhs.x, y-rhs.y, z-rhs.z);
 }
 
-inline Vector3& Vector3::operator+=(const Vector3& rhs) {
+template<typename T>
+inline Vector3T<T>& Vector3T<T>::operator+=(const Vector3T<T>& rhs) {
     x += rhs.x; y += rhs.y; z += rhs.z; return *this;
 }
 
-inline Vector3& Vector3::operator-=(const Vector3& rhs) {
+template<typename T>
+inline Vector3T<T>& Vector3T<T>::operator-=(const Vector3T<T>& rhs) {
     x -= rhs.x; y -= rhs.y; z -= rhs.z; return *this;
 }
 
-inline Vector3 Vector3::operator*(const float a) const {
-    return Vector3(x*a, y*a, z*a);
+template<typename T>
+constexpr Vector3T<T> Vector3T<T>::operator*(const T a) const {
+    return Vector3T<T>(x*a, y*a, z*a);
 }
 
-inline Vector3 Vector3::operator*(const Vector3& rhs) const {
-    return Vector3(x*rhs.x, y*rhs.y, z*rhs.z);
+template<typename T>
+constexpr Vector3T<T> Vector3T<T>::operator*(const Vector3T<T>& rhs) const {
+    return Vector3T<T>(x*rhs.x, y*rhs.y, z*rhs.z);
 }
 
-inline Vector3& Vector3::operator*=(const float a) {
+template<typename T>
+inline Vector3T<T>& Vector3T<T>::operator*=(const T a) {
     x *= a; y *= a; z *= a; return *this;
 }
 
-inline Vector3& Vector3::operator*=(const Vector3& rhs) {
+template<typename T>
+inline Vector3T<T>& Vector3T<T>::operator*=(const Vector3T<T>& rhs) {
     x *= rhs.x; y *= rhs.y; z *= rhs.z; return *this;
 }
 
-inline Vector3 Vector3::operator/(const float a) const {
-    return Vector3(x/a, y/a, z/a);
+template<typename T>
+constexpr Vector3T<T> Vector3T<T>::operator/(const T a) const {
+    return Vector3T<T>(x/a, y/a, z/a);
 }
 
-inline Vector3& Vector3::operator/=(const float a) {
+template<typename T>
+inline Vector3T<T>& Vector3T<T>::operator/=(const T a) {
     x /= a; y /= a; z /= a; return *this;
 }
 
-inline bool Vector3::operator==(const Vector3& rhs) const {
+template<typename T>
+constexpr bool Vector3T<T>::operator==(const Vector3T<T>& rhs) const {
     return (x == rhs.x) && (y == rhs.y) && (z == rhs.z);
 }
 
-inline bool Vector3::operator!=(const Vector3& rhs) const {
+template<typename T>
+constexpr bool Vector3T<T>::operator!=(const Vector3T<T>& rhs) const {
     return (x != rhs.x) || (y != rhs.y) || (z != rhs.z);
 }
 
-inline bool Vector3::operator<(const Vector3& rhs) const {
+template<typename T>
+inline bool Vector3T<T>::operator<(const Vector3T<T>& rhs) const {
     if(x < rhs.x) return true;
     if(x > rhs.x) return false;
     if(y < rhs.y) return true;
@@ -349,68 +388,88 @@ inline bool Vector3::operator<(const Vector3& rhs) const {
     return false;
 }
 
-inline float Vector3::operator[](int index) const {
+template<typename T>
+inline T Vector3T<T>::operator[](int index) const {
     return (&x)[index];
 }
 
-inline float& Vector3::operator[](int index) {
+template<typename T>
+inline T& Vector3T<T>::operator[](int index) {
     return (&x)[index];
 }
 
-inline Vector3& Vector3::set(float x, float y, float z) {
+template<typename T>
+inline Vector3T<T>& Vector3T<T>::set(T x, T y, T z) {
     this->x = x; this->y = y; this->z = z; return *this;
 }
 
-inline float Vector3::length() const {
-    return sqrtf(x*x + y*y + z*z);
+template<typename T>
+inline T Vector3T<T>::length() const {
+    return std::sqrt(x*x + y*y + z*z);
 }
 
-inline float Vector3::distance(const Vector3& vec) const {
-    return sqrtf((vec.x-x)*(vec.x-x) + (vec.y-y)*(vec.y-y) + (vec.z-z)*(vec.z-z));
+template<typename T>
+inline T Vector3T<T>::distance(const Vector3T<T>& vec) const {
+    return std::sqrt((vec.x-x)*(vec.x-x) + (vec.y-y)*(vec.y-y) + (vec.z-z)*(vec.z-z));
 }
 
-inline float Vector3::angle(const Vector3& vec) const {
+template<typename T>
+inline T Vector3T<T>::angle(const Vector3T<T>& vec) const {
     // return angle between [0, 180]
-    float l1 = this->length();
-    float l2 = vec.length();
-    float d = this->dot(vec);
-    float angle = acosf(d / (l1 * l2)) / 3.141592f * 180.0f;
+    T l1 = this->length();
+    T l2 = vec.length();
+    T d = this->dot(vec);
+    T angle = std::acos(d / (l1 * l2)) / (T)3.141592 * (T)180;
     return angle;
 }
 
-inline Vector3& Vector3::normalize() {
+template<typename T>
+inline Vector3T<T>& Vector3T<T>::normalize() {
     //@@const float EPSILON = 0.000001f;
-    float xxyyzz = x*x + y*y + z*z;
+    T xxyyzz = x*x + y*y + z*z;
     //@@if(xxyyzz < EPSILON)
     //@@    return *this; // do nothing if it is ~zero vector
 
     //float invLength = invSqrt(xxyyzz);
-    float invLength = 1.0f / sqrtf(xxyyzz);
+    T invLength = (T)1 / std::sqrt(xxyyzz);
     x *= invLength;
     y *= invLength;
     z *= invLength;
     return *this;
 }
 
-inline float Vector3::dot(const Vector3& rhs) const {
+template<typename T>
+constexpr T Vector3T<T>::dot(const Vector3T<T>& rhs) const {
     return (x*rhs.x + y*rhs.y + z*rhs.z);
 }
 
-inline Vector3 Vector3::cross(const Vector3& rhs) const {
-    return Vector3(y*rhs.z - z*rhs.y, z*rhs.x - x*rhs.z, x*rhs.y - y*rhs.x);
+template<typename T>
+constexpr Vector3T<T> Vector3T<T>::cross(const Vector3T<T>& rhs) const {
+    return Vector3T<T>(y*rhs.z - z*rhs.y, z*rhs.x - x*rhs.z, x*rhs.y - y*rhs.x);
 }
 
-inline bool Vector3::equal(const Vector3& rhs, float epsilon) const {
+template<typename T>
+inline bool Vector3T<T>::equal(const Vector3T<T>& rhs, T epsilon) const {
     return fabs(x - rhs.x) < epsilon && fabs(y - rhs.y) < epsilon && fabs(z - rhs.z) < epsilon;
 }
 
-inline Vector3 operator*(const float a, const Vector3 vec) {
-    return Vector3(a*vec.x, a*vec.y, a*vec.z);
+// fused operations, each element is computed in one pass
+// a * u + v
+template<typename T>
+constexpr Vector3T<T> mulAdd(T a, const Vector3T<T>& u, const Vector3T<T>& v) {
+    return Vector3T<T>(a*u.x + v.x, a*u.y + v.y, a*u.z + v.z);
 }
 
-inline std::ostream& operator<<(std::ostream& os, const Vector3& vec) {
-    os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ")";
-    return os;
+// a * u + b * v
+template<typename T>
+constexpr Vector3T<T> mulAdd(T a, const Vector3T<T>& u, T b, const Vector3T<T>& v) {
+    return Vector3T<T>(a*u.x + b*v.x, a*u.y + b*v.y, a*u.z + b*v.z);
+}
+
+// (u x v) * s
+template<typename T>
+constexpr Vector3T<T> crossScale(const Vector3T<T>& u, const Vector3T<T>& v, T s) {
+    return Vector3T<T>((u.y*v.z - u.z*v.y) * s, (u.z*v.x - u.x*v.z) * s, (u.x*v.y - u.y*v.x) * s);
 }
 // END OF VECTOR3 /////////////////////////////////////////////////////////////
 
@@ -419,15 +478,15 @@ inline std::ostream& operator<<(std::ostream& os, const Vector3& vec) {
 ///////////////////////////////////////////////////////////////////////////////
 // inline functions for Vector4
 ///////////////////////////////////////////////////////////////////////////////
-inline Vector4 Vector4::operator-() const {
+constexpr Vector4 Vector4::operator-() const {
     return Vector4(-x, -y, -z, -w);
 }
 
-inline Vector4 Vector4::operator+(const Vector4& rhs) const {
+constexpr Vector4 Vector4::operator+(const Vector4& rhs) const {
     return Vector4(x+rhs.x, y+rhs.y, z+rhs.z, w+rhs.w);
 }
 
-inline Vector4 Vector4::operator-(const Vector4& rhs) const {
+constexpr Vector4 Vector4::operator-(const Vector4& rhs) const {
     return Vector4(x-rhs.x, y-rhs.y, z-rhs.z, w-rhs.w);
 }
 
@@ -439,11 +498,11 @@ inline Vector4& Vector4::operator-=(const Vector4& rhs) {
     x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w; return *this;
 }
 
-inline Vector4 Vector4::operator*(const float a) const {
+constexpr Vector4 Vector4::operator*(const float a) const {
     return Vector4(x*a, y*a, z*a, w*a);
 }
 
-inline Vector4 Vector4::operator*(const Vector4& rhs) const {
+constexpr Vector4 Vector4::operator*(const Vector4& rhs) const {
     return Vector4(x*rhs.x, y*rhs.y, z*rhs.z, w*rhs.w);
 }
 
@@ -455,7 +514,7 @@ inline Vector4& Vector4::operator*=(const Vector4& rhs) {
     x *= rhs.x; y *= rhs.y; z *= rhs.z; w *= rhs.w; return *this;
 }
 
-inline Vector4 Vector4::operator/(const float a) const {
+constexpr Vector4 Vector4::operator/(const float a) const {
     return Vector4(x/a, y/a, z/a, w/a);
 }
 
@@ -463,11 +522,11 @@ inline Vector4& Vector4::operator/=(const float a) {
     x /= a; y /= a; z /= a; w /= a; return *this;
 }
 
-inline bool Vector4::operator==(const Vector4& rhs) const {
+constexpr bool Vector4::operator==(const Vector4& rhs) const {
     return (x == rhs.x) && (y == rhs.y) && (z == rhs.z) && (w == rhs.w);
 }
 
-inline bool Vector4::operator!=(const Vector4& rhs) const {
+constexpr bool Vector4::operator!=(const Vector4& rhs) const {
     return (x != rhs.x) || (y != rhs.y) || (z != rhs.z) || (w != rhs.w);
 }
 
@@ -518,7 +577,7 @@ inline Vector4& Vector4::normalize() {
     return *this;
 }
 
-inline float Vector4::dot(const Vector4& rhs) const {
+constexpr float Vector4::dot(const Vector4& rhs) const {
     return (x*rhs.x + y*rhs.y + z*rhs.z + w*rhs.w);
 }
 
@@ -527,7 +586,7 @@ inline bool Vector4::equal(const Vector4& rhs, float epsilon) const {
            fabs(z - rhs.z) < epsilon && fabs(w - rhs.w) < epsilon;
 }
 
-inline Vector4 operator*(const float a, const Vector4 vec) {
+constexpr Vector4 operator*(const float a, const Vector4 vec) {
     return Vector4(a*vec.x, a*vec.y, a*vec.z, a*vec.w);
 }
 
@@ -0,0 +1,511 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmark.cpp
+// =============
+// measure the throughput of the batch line/plane/point kernels from 1 to N
+// threads, and print the speed-up against the single thread
+// It also compares the SIMD Matrix4 operators with the scalar versions, and
+// the Vector3 operator chains with the fused functions (mulAdd, crossScale),
+// and Vector3::normalize() with the bulk normalizeVectors().
+// Before the timing, it checks the intersections of the nearly parallel
+// inputs, whose float denominator rounds to 0 or whose division overflows,
+// and exits with 1 if any of them is a hit.
+// To see the codegen difference, disassemble fusedPlanePoint() and
+// operatorPlanePoint(), e.g. "objdump -dC bench | less".
+//
+// usage: benchmark [maxThreads] [count] [grainSize]
+//   maxThreads: default is all hardware threads
+//   count     : # of lines/planes/points per kernel, default 4M
+//   grainSize : # of elements per task, default 4096
+//
+// Build with "make -f Makefile.unix bench".
+//
+// Dependencies: LineBatch, PlaneBatch, PointClassifier, ThreadPool, Matrices,
+//               MatrixBatch, Vectors, VectorBatch
+//
+// CREATED: 2026-10-17
+// UPDATED: 2026-10-17
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LineBatch.h"
+#include "PlaneBatch.h"
+#include "PointClassifier.h"
+#include "ThreadPool.h"
+#include "Matrices.h"
+#include "MatrixBatch.h"
+#include "Vectors.h"
+#include "VectorBatch.h"
+
+
+
+// constants //////////////////////////////////////////////////////////////////
+const int REPEAT_COUNT = 5;             // take the best of repeats
+const int ALL_PAIRS_COUNT = 4096;       // # of planes for intersectAll()
+const int MATRIX_COUNT = 4096;          // # of matrices per Matrix4 kernel
+const int MATRIX_LOOP_COUNT = 256;      // # of loops over the matrices
+const int VECTOR_COUNT = 4096;          // # of vectors per Vector3 kernel
+const int VECTOR_LOOP_COUNT = 256;      // # of loops over the vectors
+
+
+
+// function declarations //////////////////////////////////////////////////////
+float randomFloat(float min, float max);
+double measure(const std::function<void()>& func);
+void runKernel(const std::string& name, double items, const std::vector<int>& threadCounts,
+               int grainSize, const std::function<void(ThreadPool*)>& kernel);
+void runCompare(const std::string& name, double items,
+                const std::function<void()>& scalar, const std::function<void()>& simd);
+void runMatrixKernels();
+void runVectorKernels();
+bool checkNearlyParallel();
+Matrix4 multiplyScalar(const Matrix4& m, const Matrix4& n);
+Vector4 multiplyScalar(const Matrix4& m, const Vector4& v);
+Vector3 multiplyScalar(const Matrix4& m, const Vector3& v);
+void operatorPlanePoint(const Vector3* n1, const Vector3* n2, const float* d1, const float* d2,
+                        Vector3* points, int count);
+void fusedPlanePoint(const Vector3* n1, const Vector3* n2, const float* d1, const float* d2,
+                     Vector3* points, int count);
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    int maxThreads = (argc > 1) ? atoi(argv[1]) : (int)std::thread::hardware_concurrency();
+    int count = (argc > 2) ? atoi(argv[2]) : 4 * 1024 * 1024;
+    int grainSize = (argc > 3) ? atoi(argv[3]) : 4096;
+    if(maxThreads < 1) maxThreads = 1;
+    if(count < 1) count = 1;
+
+    // 1, 2, 4, ..., maxThreads
+    std::vector<int> threadCounts;
+    for(int n = 1; n < maxThreads; n *= 2)
+        threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+
+    printf("SIMD width: %d, count: %d, grain size: %d\n\n", SIMD_WIDTH, count, grainSize);
+
+    if(!checkNearlyParallel())
+        return 1;
+
+    // random inputs
+    LineBatch lines1, lines2;
+    PlaneBatch planes1, planes2, planes3, allPlanes;
+    std::vector<float> points(count * 3);
+    lines1.reserve(count);  lines2.reserve(count);
+    planes1.reserve(count); planes2.reserve(count); planes3.reserve(count);
+    for(int i = 0; i < count; ++i)
+    {
+        lines1.add(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1),
+                   randomFloat(-10,10), randomFloat(-10,10), randomFloat(-10,10));
+        lines2.add(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1),
+                   randomFloat(-10,10), randomFloat(-10,10), randomFloat(-10,10));
+        planes1.add(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1), randomFloat(-10,10));
+        planes2.add(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1), randomFloat(-10,10));
+        planes3.add(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1), randomFloat(-10,10));
+        points[i*3]   = randomFloat(-10,10);
+        points[i*3+1] = randomFloat(-10,10);
+        points[i*3+2] = randomFloat(-10,10);
+    }
+    for(int i = 0; i < ALL_PAIRS_COUNT; ++i)
+        allPlanes.add(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1), randomFloat(-10,10));
+
+    // outputs
+    Plane plane(1, 2, 3, 4);
+    Line line(Vector3(1, 2, 3), Vector3(4, 5, 6));
+    LineBatch outLines;
+    std::vector<float> t, x, y, z;
+    PlaneBatch::FloatArray px, py, pz;
+    std::vector<int> indices1, indices2;
+    std::vector<unsigned char> status, codes((count + 3) / 4);
+
+    runKernel("LineBatch::intersect(Plane)", count, threadCounts, grainSize, [&](ThreadPool* pool)
+    {
+        lines1.intersect(plane, t, status, -INFINITY, INFINITY, pool);
+    });
+    runKernel("LineBatch::closestPoints()", count, threadCounts, grainSize, [&](ThreadPool* pool)
+    {
+        lines1.closestPoints(lines2, t, x, y, INFINITY, pool);
+    });
+    runKernel("PlaneBatch::intersect(Line)", count, threadCounts, grainSize, [&](ThreadPool* pool)
+    {
+        planes1.intersect(line, t, status, -INFINITY, INFINITY, pool);
+    });
+    runKernel("PlaneBatch::intersect(PlaneBatch)", count, threadCounts, grainSize, [&](ThreadPool* pool)
+    {
+        planes1.intersect(planes2, outLines, status, pool);
+    });
+    runKernel("PlaneBatch::intersect(PlaneBatch x2)", count, threadCounts, grainSize, [&](ThreadPool* pool)
+    {
+        planes1.intersect(planes2, planes3, px, py, pz, status, pool);
+    });
+    runKernel("PlaneBatch::intersectAll()", ALL_PAIRS_COUNT * (ALL_PAIRS_COUNT - 1) / 2.0,
+              threadCounts, grainSize, [&](ThreadPool* pool)
+    {
+        outLines.clear();
+        allPlanes.intersectAll(outLines, indices1, indices2, pool);
+    });
+    runKernel("PointClassifier::classify()", count, threadCounts, grainSize, [&](ThreadPool* pool)
+    {
+        PointClassifier classifier(plane, 0.1f);
+        classifier.setThreadPool(pool);
+        classifier.classify(&points[0], count, &codes[0]);
+    });
+
+    runMatrixKernels();
+    runVectorKernels();
+
+    return 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// check the nearly parallel inputs, return false if any of them is a hit
+// V1 = (1+2^-23, 1+2^-22, 0) and V2 = (1, 1+2^-23, 0) are not exactly
+// parallel (V1 x V2 = (0, 0, 2^-46)), but V1 x V2 rounds to 0 in float.
+// Same for N.V = 2^-46 of the line and plane. The last line has a subnormal
+// N.V, so t = -(N.p + d) / N.V overflows to inf.
+///////////////////////////////////////////////////////////////////////////////
+bool checkNearlyParallel()
+{
+    const float e = ldexpf(1, -23);
+    Vector3 v1(1 + e, 1 + 2 * e, 0);
+    Vector3 v2(1, 1 + e, 0);
+    Line line1(v1, Vector3(0, 0, 0));
+    Line line2(v2, Vector3(0, 1, 0));
+    Plane plane1(v1.x, v1.y, v1.z, 0);
+    Plane plane2(v2.x, v2.y, v2.z, 1);
+    Plane plane3(1 + e, -(1 + 2 * e), 0, 1);
+    Line line3(Vector3(1 + e, 1, 0), Vector3(0, 0, 0));
+
+    bool passed = true;
+    passed &= line1.getIntersection(line2).status == INTERSECTION_PARALLEL;
+    passed &= !line1.isIntersected(line2);
+    passed &= std::isnan(line1.intersect(line2).x);
+    passed &= plane1.getIntersection(plane2).status == INTERSECTION_PARALLEL;
+    passed &= !plane1.isIntersected(plane2);
+    passed &= plane3.getIntersection(line3).status == INTERSECTION_PARALLEL;
+    passed &= !plane3.isIntersected(line3);
+
+    Plane plane4(1, 0, 0, 0);
+    Line line4(Vector3(1e-39f, 1, 0), Vector3(1, 0, 0));
+    LineBatch lines4(&line4, 1);
+    PlaneBatch planes4(&plane4, 1);
+    std::vector<float> t;
+    std::vector<unsigned char> status;
+    passed &= plane4.getIntersection(line4).status == INTERSECTION_PARALLEL;
+    passed &= lines4.intersect(plane4, t, status, -INFINITY, INFINITY) == 0;
+    passed &= status[0] == INTERSECTION_PARALLEL && t[0] == 0;
+    passed &= planes4.intersect(line4, t, status, -INFINITY, INFINITY) == 0;
+    passed &= status[0] == INTERSECTION_PARALLEL && t[0] == 0;
+
+    // the batch functions use the same rules as the scalar functions
+    // (sin^2 = 1e-12, the cross and dot products are not 0 after rounding)
+    Plane planes[2] = { Plane(1, 0, 0, 0), Plane(1, 1e-6f, 0, 1) };
+    PlaneBatch planes5(&planes[0], 1), planes6(&planes[1], 1), planes56(planes, 2);
+    LineBatch lines;
+    std::vector<int> indices1, indices2;
+    passed &= planes[0].getIntersection(planes[1]).status == INTERSECTION_PARALLEL;
+    passed &= planes5.intersect(planes6, lines, status) == 0 && status[0] == INTERSECTION_PARALLEL;
+    passed &= planes56.intersectAll(lines, indices1, indices2) == 0;
+
+    Line line5(Vector3(1e-6f, 1, 0), Vector3(1, 0, 0));
+    passed &= planes[0].getIntersection(line5).status == INTERSECTION_PARALLEL;
+    passed &= planes5.intersect(line5, t, status) == 0 && status[0] == INTERSECTION_PARALLEL;
+
+    // on the plane, but N.p + d = 6e-8 after rounding
+    Plane plane6(3, 2, 0, -0.7f);
+    Line line6(Vector3(2, -3, 0), Vector3(0.1f, 0.2f, 0));
+    passed &= plane6.getIntersection(line6).status == INTERSECTION_COINCIDENT;
+    passed &= LineBatch(&line6, 1).intersect(plane6, t, status) == 0;
+    passed &= status[0] == INTERSECTION_COINCIDENT;
+
+    printf("Nearly parallel inputs: %s\n\n", passed ? "OK" : "FAILED");
+    return passed;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare Matrix4 operators (SIMD if the build has it) with the scalar ones
+///////////////////////////////////////////////////////////////////////////////
+void runMatrixKernels()
+{
+    std::vector<Matrix4> m1(MATRIX_COUNT), m2(MATRIX_COUNT), m3(MATRIX_COUNT);
+    std::vector<Vector4> v4(MATRIX_COUNT), r4(MATRIX_COUNT);
+    std::vector<Vector3> v3(MATRIX_COUNT), r3(MATRIX_COUNT);
+    for(int i = 0; i < MATRIX_COUNT; ++i)
+    {
+        for(int j = 0; j < 16; ++j)
+        {
+            m1[i][j] = randomFloat(-1, 1);
+            m2[i][j] = randomFloat(-1, 1);
+        }
+        v4[i].set(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1));
+        v3[i].set(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1));
+    }
+
+    double items = (double)MATRIX_COUNT * MATRIX_LOOP_COUNT;
+    printf("Matrix4 (single thread, SIMD width 4%s)\n", (SIMD_WIDTH > 1) ? "" : " not available");
+    printf("  operator       scalar M/s     SIMD M/s   speed-up\n");
+    runCompare("M * M", items, [&]()
+    {
+        for(int k = 0; k < MATRIX_LOOP_COUNT; ++k)
+            for(int i = 0; i < MATRIX_COUNT; ++i)
+                m3[i] = multiplyScalar(m1[i], m2[i]);
+    }, [&]()
+    {
+        for(int k = 0; k < MATRIX_LOOP_COUNT; ++k)
+            for(int i = 0; i < MATRIX_COUNT; ++i)
+                m3[i] = m1[i] * m2[i];
+    });
+    runCompare("M * Vector4", items, [&]()
+    {
+        for(int k = 0; k < MATRIX_LOOP_COUNT; ++k)
+            for(int i = 0; i < MATRIX_COUNT; ++i)
+                r4[i] = multiplyScalar(m1[i], v4[i]);
+    }, [&]()
+    {
+        for(int k = 0; k < MATRIX_LOOP_COUNT; ++k)
+            for(int i = 0; i < MATRIX_COUNT; ++i)
+                r4[i] = m1[i] * v4[i];
+    });
+    runCompare("M * Vector3", items, [&]()
+    {
+        for(int k = 0; k < MATRIX_LOOP_COUNT; ++k)
+            for(int i = 0; i < MATRIX_COUNT; ++i)
+                r3[i] = multiplyScalar(m1[i], v3[i]);
+    }, [&]()
+    {
+        for(int k = 0; k < MATRIX_LOOP_COUNT; ++k)
+            for(int i = 0; i < MATRIX_COUNT; ++i)
+                r3[i] = m1[i] * v3[i];
+    });
+    std::vector<float> determinants;
+    std::vector<unsigned char> singular;
+    runCompare("invert", items, [&]()
+    {
+        for(int k = 0; k < MATRIX_LOOP_COUNT; ++k)
+            for(int i = 0; i < MATRIX_COUNT; ++i)
+                m3[i] = m1[i].invertGeneral();
+    }, [&]()
+    {
+        for(int k = 0; k < MATRIX_LOOP_COUNT; ++k)
+            invertMatrices(&m1[0], MATRIX_COUNT, determinants, singular);
+    });
+    printf("\n");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare the chains of Vector3 operators with the fused functions
+///////////////////////////////////////////////////////////////////////////////
+void runVectorKernels()
+{
+    std::vector<Vector3> n1(VECTOR_COUNT), n2(VECTOR_COUNT), v(VECTOR_COUNT), r(VECTOR_COUNT);
+    std::vector<float> d1(VECTOR_COUNT), d2(VECTOR_COUNT);
+    for(int i = 0; i < VECTOR_COUNT; ++i)
+    {
+        n1[i].set(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1));
+        n2[i].set(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1));
+        v[i].set(randomFloat(-1,1), randomFloat(-1,1), randomFloat(-1,1));
+        d1[i] = randomFloat(-10, 10);
+        d2[i] = randomFloat(-10, 10);
+    }
+
+    double items = (double)VECTOR_COUNT * VECTOR_LOOP_COUNT;
+    printf("Vector3 (single thread)\n");
+    printf("  formula      operator M/s    fused M/s   speed-up\n");
+    runCompare("p + t * v", items, [&]()
+    {
+        for(int k = 0; k < VECTOR_LOOP_COUNT; ++k)
+            for(int i = 0; i < VECTOR_COUNT; ++i)
+                r[i] = n1[i] + (d1[i] * v[i]);
+    }, [&]()
+    {
+        for(int k = 0; k < VECTOR_LOOP_COUNT; ++k)
+            for(int i = 0; i < VECTOR_COUNT; ++i)
+                r[i] = mulAdd(d1[i], v[i], n1[i]);
+    });
+    runCompare("2 planes", items, [&]()
+    {
+        for(int k = 0; k < VECTOR_LOOP_COUNT; ++k)
+            operatorPlanePoint(&n1[0], &n2[0], &d1[0], &d2[0], &r[0], VECTOR_COUNT);
+    }, [&]()
+    {
+        for(int k = 0; k < VECTOR_LOOP_COUNT; ++k)
+            fusedPlanePoint(&n1[0], &n2[0], &d1[0], &d2[0], &r[0], VECTOR_COUNT);
+    });
+    printf("\n");
+
+    // Vector3::normalize() vs normalizeVectors() with each accuracy
+    printf("Vector3 normalize (single thread, SIMD width %d)\n", SIMD_WIDTH);
+    printf("  accuracy       scalar M/s     SIMD M/s   speed-up\n");
+    const char* names[] = { "fast", "newton", "exact" };
+    const SqrtAccuracy accuracies[] = { SQRT_FAST, SQRT_NEWTON, SQRT_EXACT };
+    for(int a = 0; a < 3; ++a)
+    {
+        runCompare(names[a], items, [&]()
+        {
+            for(int k = 0; k < VECTOR_LOOP_COUNT; ++k)
+                for(int i = 0; i < VECTOR_COUNT; ++i)
+                    (r[i] = v[i]).normalize();
+        }, [&]()
+        {
+            for(int k = 0; k < VECTOR_LOOP_COUNT; ++k)
+                normalizeVectors(&v[0].x, VECTOR_COUNT, &r[0].x, accuracies[a]);
+        });
+    }
+    printf("\n");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// run a kernel with 1 to N threads, and print items per second
+///////////////////////////////////////////////////////////////////////////////
+void runKernel(const std::string& name, double items, const std::vector<int>& threadCounts,
+               int grainSize, const std::function<void(ThreadPool*)>& kernel)
+{
+    printf("%s\n", name.c_str());
+    printf("  threads    M items/s   speed-up\n");
+
+    double baseTime = 0;
+    for(size_t i = 0; i < threadCounts.size(); ++i)
+    {
+        ThreadPool pool(threadCounts[i], grainSize);
+        kernel(&pool);      // warm up
+
+        double best = measure([&]() { kernel(&pool); });
+        for(int j = 1; j < REPEAT_COUNT; ++j)
+        {
+            double time = measure([&]() { kernel(&pool); });
+            if(time < best)
+                best = time;
+        }
+        if(i == 0)
+            baseTime = best;
+
+        printf("  %7d %12.1f %9.2fx\n", threadCounts[i], items / best * 1e-6, baseTime / best);
+    }
+    printf("\n");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// run the scalar and SIMD versions of a kernel, and print items per second
+///////////////////////////////////////////////////////////////////////////////
+void runCompare(const std::string& name, double items,
+                const std::function<void()>& scalar, const std::function<void()>& simd)
+{
+    scalar();   // warm up
+    simd();
+
+    double scalarTime = measure(scalar);
+    double simdTime = measure(simd);
+    for(int i = 1; i < REPEAT_COUNT; ++i)
+    {
+        scalarTime = std::min(scalarTime, measure(scalar));
+        simdTime = std::min(simdTime, measure(simd));
+    }
+
+    printf("  %-12s %12.1f %12.1f %9.2fx\n", name.c_str(),
+           items / scalarTime * 1e-6, items / simdTime * 1e-6, scalarTime / simdTime);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// scalar Matrix4 operators (the plain C++ versions in Matrices.h)
+///////////////////////////////////////////////////////////////////////////////
+Matrix4 multiplyScalar(const Matrix4& m, const Matrix4& n)
+{
+    Matrix4 r;
+    for(int j = 0; j < 16; j += 4)
+    {
+        for(int i = 0; i < 4; ++i)
+            r[j+i] = m[i]*n[j] + m[i+4]*n[j+1] + m[i+8]*n[j+2] + m[i+12]*n[j+3];
+    }
+    return r;
+}
+
+Vector4 multiplyScalar(const Matrix4& m, const Vector4& v)
+{
+    return Vector4(m[0]*v.x + m[4]*v.y + m[8]*v.z  + m[12]*v.w,
+                   m[1]*v.x + m[5]*v.y + m[9]*v.z  + m[13]*v.w,
+                   m[2]*v.x + m[6]*v.y + m[10]*v.z + m[14]*v.w,
+                   m[3]*v.x + m[7]*v.y + m[11]*v.z + m[15]*v.w);
+}
+
+Vector3 multiplyScalar(const Matrix4& m, const Vector3& v)
+{
+    return Vector3(m[0]*v.x + m[4]*v.y + m[8]*v.z + m[12],
+                   m[1]*v.x + m[5]*v.y + m[9]*v.z + m[13],
+                   m[2]*v.x + m[6]*v.y + m[10]*v.z+ m[14]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// the point on the intersection line of 2 planes, same as Plane::intersect()
+// p = (d2*N1 - d1*N2) x V / (V.V), where V = N1 x N2
+// operatorPlanePoint() uses the operators, and fusedPlanePoint() uses the
+// fused functions of Vector3.
+///////////////////////////////////////////////////////////////////////////////
+void operatorPlanePoint(const Vector3* n1, const Vector3* n2, const float* d1, const float* d2,
+                        Vector3* points, int count)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        Vector3 v = n1[i].cross(n2[i]);
+        float dot = v.dot(v);
+        Vector3 a = d2[i] * n1[i];
+        Vector3 b = -d1[i] * n2[i];
+        points[i] = (a + b).cross(v) / dot;
+    }
+}
+
+void fusedPlanePoint(const Vector3* n1, const Vector3* n2, const float* d1, const float* d2,
+                     Vector3* points, int count)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        Vector3 v = n1[i].cross(n2[i]);
+        float dot = v.dot(v);
+        points[i] = crossScale(mulAdd(d2[i], n1[i], -d1[i], n2[i]), v, 1 / dot);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return elapsed time of func in sec
+///////////////////////////////////////////////////////////////////////////////
+double measure(const std::function<void()>& func)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return a random number in [min, max]
+///////////////////////////////////////////////////////////////////////////////
+float randomFloat(float min, float max)
+{
+    return min + (max - min) * rand() / (float)RAND_MAX;
+}
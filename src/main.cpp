@@ -5,7 +5,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-01-20
-// UPDATED: 2020-07-22
+// UPDATED: 2026-10-17
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef __APPLE__
@@ -19,6 +19,7 @@
 #include <sstream>
 #include <iomanip>
 #include "Matrices.h"
+#include "Quaternion.h"
 #include "Plane.h"
 #include "Line.h"
 #include "Cylinder.h"
@@ -63,7 +64,6 @@ const float CAMERA_ANGLE_X  = 45.0f;
 const float CAMERA_ANGLE_Y  = -45.0f;
 const int   TEXT_WIDTH      = 8;
 const int   TEXT_HEIGHT     = 13;
-const float DEG2RAD         = acos(-1);
 
 // global variables
 void *font = GLUT_BITMAP_8_BY_13;
@@ -468,10 +468,10 @@ void drawLine(const Line& line, const Vector3& color)
 
     // transform cylinder
     glPushMatrix();
-    Matrix4 m, r;
-    r.lookAt(v);
-    m.scale(0.1f, 0.1f, 40);
-    m = r * m;  // apply lookat rotation
+    // the instanced cylinder scales the unit mesh in draw(), no rebuild
+    cylinder.set(0.1f, 0.1f, 40, cylinder.getSectorCount(), cylinder.getStackCount());
+    Matrix4 m;
+    m.lookAt(v);    // apply lookat rotation
     m.translate(p);
     m = matrixView * m;
     glLoadMatrixf(m.get());
@@ -647,6 +647,7 @@ bool initSharedMem()
     color1.set(0.8f, 0.9f, 0.8f);   // plane1
     color2.set(0.8f, 0.8f, 0.9f);   // plane2
     color3.set(1.0f, 0.5f, 0.0f);   // line
+    cylinder.setInstanced(true);    // to draw line with any size
 
     screenWidth = SCREEN_WIDTH;
     screenHeight = SCREEN_HEIGHT;
@@ -806,9 +807,10 @@ void displayCB()
     glPushMatrix();
 
     // tramsform camera
-    matrixView.identity();
-    matrixView.rotateY(cameraAngleY);
-    matrixView.rotateX(cameraAngleX);
+    // rotate on Y-axis first, then X-axis
+    Quaternion cameraRotation = Quaternion(Vector3(1, 0, 0), cameraAngleX) *
+                                Quaternion(Vector3(0, 1, 0), cameraAngleY);
+    matrixView = cameraRotation.getMatrix();
     matrixView.translate(0, 0, -cameraDistance);
     glLoadMatrixf(matrixView.get());
 